@@ -0,0 +1,111 @@
+#include "services/game/entity_codec.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace Core::App::Game;
+
+namespace
+{
+    struct Shape
+    {
+        const char * name;
+        std::size_t snakes;
+        std::size_t points;  // per snake
+        Net::SnakePointsKind pointsKind;
+        std::size_t foods;
+        std::size_t removes;
+    };
+
+    // what one viewer receives on a busy arena: a PartialUpdate in motion, a FullUpdate on (re)spawn
+    constexpr Shape Shapes[] {
+        { "PartialUpdate", 12, 16, Net::SnakePointsKind::ValidationSamples, 40, 30 },
+        { "FullUpdate", 30, 120, Net::SnakePointsKind::FullSegments, 600, 0 },
+    };
+
+    void Fill(EntityPayloadWriter & writer, const Shape & shape, std::mt19937 & random)
+    {
+        const auto center = Utils::Legacy::Game::AreaCenter;
+        const float radius = Utils::Legacy::Game::AreaRadius;
+
+        std::uniform_real_distribution<float> coordinate(-radius * 0.7f, radius * 0.7f);
+        std::uniform_int_distribution<std::uint32_t> power(1, 30);
+
+        std::uint32_t entityID = 1000;
+
+        for (std::size_t i = 0; i < shape.removes; ++i)
+            writer.WriteRemove(Net::EntityType::Food, entityID += 1 + i % 3);
+
+        std::vector<sf::Vector2f> points(shape.points);
+        for (std::size_t i = 0; i < shape.snakes; ++i)
+        {
+            sf::Vector2f position { center.x + coordinate(random), center.y + coordinate(random) };
+            for (auto & point : points)
+            {
+                point = position;
+                position.x += 6.0f;
+            }
+
+            Net::SnakeState state{};
+            state.headX = points.front().x;
+            state.headY = points.front().y;
+            state.experience = 100 + static_cast<std::uint32_t>(i) * 37;
+            state.totalSegments = static_cast<std::uint16_t>(shape.points * 2);
+            state.pointsKind = shape.pointsKind;
+            state.pointsCount = static_cast<std::uint16_t>(points.size());
+
+            writer.WriteSnake(Net::EntityFlags::Update, entityID += 7, state, points);
+        }
+
+        for (std::size_t i = 0; i < shape.foods; ++i)
+        {
+            Net::FoodState state{};
+            state.x = center.x + coordinate(random);
+            state.y = center.y + coordinate(random);
+            state.power = power(random);
+            state.color = { 200, 80, 40, 255 };
+
+            writer.WriteFood(Net::EntityFlags::New, entityID += 1 + i % 5, state);
+        }
+    }
+
+    void Run(const Shape & shape, const int iterations)
+    {
+        std::size_t sizes[2] {};
+        double nanos[2] {};
+
+        for (const bool compact : { false, true })
+        {
+            std::mt19937 random(42);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i)
+            {
+                const auto writer = EntityPayloadWriter::Create(compact, 64 * 1024);
+                Fill(*writer, shape, random);
+                sizes[compact] = writer->Finish().size();
+            }
+            nanos[compact] = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / iterations;
+        }
+
+        std::printf("%-14s legacy %7zu B %8.1f us   compact %7zu B %8.1f us   %.1f%% of legacy\n",
+                    shape.name,
+                    sizes[0], nanos[0] / 1e3,
+                    sizes[1], nanos[1] / 1e3,
+                    100.0 * static_cast<double>(sizes[1]) / static_cast<double>(sizes[0]));
+    }
+}
+
+int main(const int argc, char ** argv)
+{
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+
+    for (const auto & shape : Shapes)
+        Run(shape, iterations);
+
+    return 0;
+}
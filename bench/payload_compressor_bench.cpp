@@ -0,0 +1,72 @@
+#include "services/game/payload_compressor.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+using namespace Core::App::Game;
+
+// Compression ratio and encode time over payloads captured with GAME_COMPRESSION_CAPTURE_DIR.
+//   payload_compressor_bench <capture dir> [dictionary] [level] [repeat]
+int main(const int argc, char ** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <capture dir> [dictionary] [level] [repeat]\n", argv[0]);
+        return 2;
+    }
+
+    CompressionConfig config;
+    config.enabled = true;
+    config.dictionaryPath = argc > 2 ? argv[2] : "";
+    config.level = argc > 3 ? std::atoi(argv[3]) : config.level;
+    const int repeat = argc > 4 ? std::max(1, std::atoi(argv[4])) : 10;
+
+    // "full_update_000042.bin" -> "full_update"
+    std::map<std::string, std::vector<std::vector<std::uint8_t>>> samples;
+    for (const auto & entry : std::filesystem::directory_iterator(argv[1]))
+    {
+        const auto name = entry.path().stem().string();
+        const auto split = name.rfind('_');
+        if (entry.path().extension() != ".bin" || split == std::string::npos)
+            continue;
+
+        std::ifstream file(entry.path(), std::ios::binary);
+        samples[name.substr(0, split)].emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    if (samples.empty())
+    {
+        std::fprintf(stderr, "no captured payloads in '%s'\n", argv[1]);
+        return 2;
+    }
+
+    for (const auto & [kind, payloads] : samples)
+    {
+        PayloadCompressor compressor;
+        if (const auto error = compressor.Initialise(config); !error.empty())
+        {
+            std::fprintf(stderr, "compressor: %s\n", error.c_str());
+            return 2;
+        }
+
+        std::vector<std::uint8_t> out;
+        for (int i = 0; i < repeat; ++i)
+        {
+            for (const auto & payload : payloads)
+                compressor.Compress(payload, out);
+        }
+
+        const auto & stats = compressor.Stats();
+        std::printf("%-16s samples=%zu level=%d dict=%u compressed=%llu skipped=%llu ratio=%.2f encode=%.1fus/msg\n",
+                    kind.c_str(), payloads.size(), config.level, compressor.DictionaryID(),
+                    static_cast<unsigned long long>(stats.messages), static_cast<unsigned long long>(stats.skipped),
+                    stats.Ratio(), stats.EncodeMicrosPerMessage());
+    }
+
+    return 0;
+}
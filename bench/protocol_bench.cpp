@@ -0,0 +1,145 @@
+#include "servers/websocket/msgpack.hpp"
+#include "servers/websocket/parse_arena.hpp"
+#include "servers/websocket/protocol.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace Core::Servers::Websocket;
+
+namespace
+{
+    struct Sample
+    {
+        std::string type;
+        boost::json::object body;
+    };
+
+    std::vector<Sample> MakeSamples()
+    {
+        std::vector<Sample> samples;
+
+        samples.push_back({ "player_session::login", { { "login", "player_0042" }, { "password", "correct horse battery staple" } } });
+
+        boost::json::array leaderboard;
+        for (int i = 0; i < 10; ++i)
+            leaderboard.push_back(boost::json::object{ { "name", "player_" + std::to_string(i) }, { "exp", 100000 - i * 7919 } });
+        samples.push_back({ "player_session::leaderboard::update", { { "serverId", 3 }, { "leaderboard", std::move(leaderboard) } } });
+
+        boost::json::array sessions;
+        for (int i = 0; i < 8; ++i)
+            sessions.push_back(boost::json::object{ { "id", i }, { "players", 40 + i }, { "host", "10.0.0." + std::to_string(i) }, { "port", 7000 + i } });
+        samples.push_back({ "player_session::stats::update", { { "sessions", std::move(sessions) }, { "online", true }, { "load", 0.625 } } });
+
+        return samples;
+    }
+
+    // what the client writes: the JSON envelope around the serialized body, or the binary envelope plus MessagePack
+    std::string SerializeJson(const Sample & sample, const uint64_t sourceJobID)
+    {
+        std::string out = R"({"type":)";
+        out += boost::json::serialize(boost::json::string_view(sample.type));
+        out += R"(,"headers":{"sourceJobId":)";
+        out += std::to_string(sourceJobID);
+        out += R"(,"targetJobId":0},"message":)";
+        out += boost::json::serialize(sample.body);
+        out += '}';
+        return out;
+    }
+
+    std::vector<uint8_t> SerializeBinary(const MessageTypes & types, const Sample & sample, const uint64_t sourceJobID)
+    {
+        std::vector<uint8_t> packed;
+        EncodeMsgPack(sample.body, packed);
+
+        std::vector<uint8_t> frame;
+        frame.reserve(packed.size() + 24);
+        EncodeBinaryEnvelope(frame, types.Find(sample.type), sample.type, sourceJobID, 0);
+        frame.insert(frame.end(), packed.begin(), packed.end());
+        return frame;
+    }
+
+    // what the server does before dispatch: the tree into an arena, the type looked up, the body checked
+    bool ParseJson(const MessageTypes & types, boost::json::parser & parser, ParseArena & arena, const std::string & text)
+    {
+        arena.Reset();
+        parser.reset(arena.Resource());
+
+        boost::system::error_code ec;
+        parser.write(text, ec);
+        if (ec)
+            return false;
+
+        const auto value = parser.release();
+        const auto * type = value.as_object().if_contains("type");
+        const auto * body = value.as_object().if_contains("message");
+        return type && type->is_string() && types.Find(type->get_string()) != 0 && body && body->is_object();
+    }
+
+    bool ParseBinary(const MessageTypes & types, ParseArena & arena, const std::vector<uint8_t> & frame)
+    {
+        arena.Reset();
+
+        BinaryEnvelope envelope;
+        if (!DecodeBinaryEnvelope(frame, envelope) || types.Name(envelope.typeID) == nullptr)
+            return false;
+
+        std::size_t offset = envelope.bodyOffset;
+        boost::json::value body(arena.Resource());
+        return DecodeMsgPack(frame, offset, body) && offset == frame.size() && body.is_object();
+    }
+
+    template<typename F>
+    double NanosPerCall(const int iterations, F && f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            f(i);
+
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / iterations;
+    }
+}
+
+// Parse and serialize cost of the JSON and the binary protocol for typical messages.
+//   protocol_bench [iterations]
+int main(const int argc, char ** argv)
+{
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 100000;
+
+    const auto samples = MakeSamples();
+
+    MessageTypes types;
+    for (const auto & sample : samples)
+        types.Intern(sample.type);
+
+    boost::json::parser parser;
+    ParseArena arena(8192);
+    std::size_t sink = 0;
+
+    for (const auto & sample : samples)
+    {
+        const auto text = SerializeJson(sample, 1);
+        const auto frame = SerializeBinary(types, sample, 1);
+        if (!ParseJson(types, parser, arena, text) || !ParseBinary(types, arena, frame))
+        {
+            std::fprintf(stderr, "%s: does not parse back\n", sample.type.c_str());
+            return 2;
+        }
+
+        const auto jsonSerialize = NanosPerCall(iterations, [&](const int i) { sink += SerializeJson(sample, i).size(); });
+        const auto jsonParse = NanosPerCall(iterations, [&](int) { sink += ParseJson(types, parser, arena, text); });
+        const auto binarySerialize = NanosPerCall(iterations, [&](const int i) { sink += SerializeBinary(types, sample, i).size(); });
+        const auto binaryParse = NanosPerCall(iterations, [&](int) { sink += ParseBinary(types, arena, frame); });
+
+        std::printf("%-36s json %5zu B parse %6.2f us serialize %6.2f us   binary %5zu B parse %6.2f us serialize %6.2f us\n",
+                    sample.type.c_str(),
+                    text.size(), jsonParse / 1e3, jsonSerialize / 1e3,
+                    frame.size(), binaryParse / 1e3, binarySerialize / 1e3);
+    }
+
+    return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+#include "servers/websocket/message.hpp"
+#include "servers/websocket/protocol.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <unordered_map>
+
+using namespace Core::Servers::Websocket;
+
+namespace
+{
+    using Handler = std::function<std::size_t(Interface::Message &)>;
+
+    // stands in for WebsocketService as the parent of every message
+    class Parent final : public Core::BaseServiceContainer
+    {
+        std::string GetServiceContainerName() const override
+        {
+            return "WebsocketService";
+        }
+    };
+
+    // The request path before messages became lightweight: the library parses into the default allocator,
+    // the frame is re-serialized for the debug log, headers and message are each make_shared with a child
+    // logger, the body is copied and the handler is looked up by name.
+    namespace Before
+    {
+        class Headers final : public Core::BaseServiceContainer
+        {
+        public:
+            Interface::Headers value;
+
+            std::string GetServiceContainerName() const override
+            {
+                return "Headers";
+            }
+        };
+
+        class Message final : public Interface::Message
+        {
+            std::shared_ptr<Headers> headers_;
+            std::string type_;
+            boost::json::object body_;
+
+        public:
+            Message(std::shared_ptr<Headers> headers, std::string type, boost::json::object body):
+            headers_(std::move(headers)), type_(std::move(type)), body_(std::move(body)) {}
+
+            const Interface::Headers & GetHeaders() const override { return headers_->value; }
+            const std::string & GetType() const override { return type_; }
+            uint32_t GetTypeID() const override { return 0; }
+            boost::json::object & GetBody() override { return body_; }
+            std::string ToString() const override { return boost::json::serialize(body_); }
+
+        private:
+            std::string GetServiceContainerName() const override
+            {
+                return type_;
+            }
+        };
+
+        std::size_t Handle(const Parent & parent, const std::unordered_map<std::string, std::vector<Handler>> & handlers, const std::string_view text)
+        {
+            boost::system::error_code ec;
+            const auto value = boost::json::parse(text, ec);
+            if (ec)
+                return 0;
+
+            const auto logged = boost::json::serialize(value);
+
+            const auto & obj = value.as_object();
+
+            const auto headers = std::make_shared<Headers>();
+            headers->value = ParseHeaders(obj.at("headers").as_object());
+            headers->SetupContainer(parent);
+
+            const std::string type(obj.at("type").as_string());
+
+            const auto message = std::make_shared<Message>(headers, type, obj.at("message").as_object());
+            message->SetupContainer(parent);
+
+            std::size_t result = logged.size();
+            if (const auto it = handlers.find(type); it != handlers.end())
+            {
+                for (const auto & handler : it->second)
+                    result += handler(*message);
+            }
+            return result;
+        }
+    }
+
+    // The current request path of WebsocketService::HandleText / HandleMessage
+    namespace After
+    {
+        std::size_t Handle(const Parent & parent, const MessageTypes & types, const std::vector<std::vector<Handler>> & handlers,
+                           boost::json::parser & parser, const ParseArenaPool::Shared & arenas, const std::string_view text)
+        {
+            auto lease = arenas->Acquire();
+
+            boost::system::error_code ec;
+            parser.reset(lease.Storage());
+            parser.write(text, ec);
+            if (ec)
+                return 0;
+
+            auto value = parser.release();
+            parser.reset();
+
+            auto & obj = value.as_object();
+
+            const auto headers = ParseHeaders(obj.at("headers").as_object());
+            const std::string_view type = obj.at("type").as_string();
+
+            const auto typeID = types.Find(type);
+            auto & body = obj.at("message").as_object();
+            const auto message = typeID
+                ? Message::Create(&parent, headers, typeID, *types.Name(typeID), std::move(body), std::move(lease))
+                : Message::Create(&parent, headers, std::string(type), std::move(body), std::move(lease));
+
+            std::size_t result = 0;
+            if (typeID < handlers.size())
+            {
+                for (const auto & handler : handlers[typeID])
+                    result += handler(*message);
+            }
+            return result;
+        }
+    }
+
+    template<typename F>
+    double RequestsPerSecond(const int iterations, F && f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            f();
+
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return iterations / std::max(seconds, 1e-9);
+    }
+}
+
+// Requests per second through parse + message construction + dispatch, before and after lightweight messages.
+//   websocket_message_bench [iterations]
+int main(const int argc, char ** argv)
+{
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200000;
+
+    const std::string type = "player_session::login";
+    const Handler handler = [](Interface::Message & message)
+    {
+        const auto * login = message.GetBody().if_contains("login");
+        return login && login->is_string() ? login->get_string().size() : 0;
+    };
+
+    const std::vector<std::string> requests {
+        R"({"type":"player_session::login","headers":{"sourceJobId":17,"targetJobId":0},"message":{"login":"player_0042","password":"correct horse battery staple"}})",
+        R"({"type":"player_session::login","headers":{"sourceJobId":18,"targetJobId":0},"message":{"login":"player_0042","password":"x","client":{"version":"1.4.2","platform":"web","features":["binary","compression","lod"]}}})",
+    };
+
+    Parent parent;
+
+    std::unordered_map<std::string, std::vector<Handler>> beforeHandlers;
+    beforeHandlers[type].push_back(handler);
+
+    MessageTypes types;
+    std::vector<std::vector<Handler>> afterHandlers;
+    const auto typeID = types.Intern(type);
+    afterHandlers.resize(typeID + 1);
+    afterHandlers[typeID].push_back(handler);
+
+    boost::json::parser parser;
+    const auto arenas = ParseArenaPool::Create(8192, 4);
+
+    std::size_t sink = 0;
+    for (const auto & request : requests)
+    {
+        const auto before = RequestsPerSecond(iterations, [&] { sink += Before::Handle(parent, beforeHandlers, request); });
+        const auto after = RequestsPerSecond(iterations, [&] { sink += After::Handle(parent, types, afterHandlers, parser, arenas, request); });
+
+        std::printf("%4zu B request   before %10.0f req/s   after %10.0f req/s   x%.2f\n",
+                    request.size(), before, after, after / before);
+    }
+
+    return sink == 0 ? 1 : 0;
+}
@@ -4,6 +4,11 @@
 #include <service_loader.hpp>
 #include <interface_controller.hpp>
 
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
 namespace Core {
     using Loader = Utils::Service::Loader;
     using InterfaceController = Utils::Service::InterfaceController;
@@ -20,6 +25,112 @@ namespace Core {
         return interfaceController;
     }
 
+    // Work that has to finish before the process exits (SIGINT / SIGTERM). The main loop keeps
+    // ticking the services and polls every hook until it returns true or the deadline passes.
+    class ShutdownHooks
+    {
+        struct Hook
+        {
+            std::string name;
+            std::function<bool()> poll;
+            bool done = false;
+        };
+
+        std::mutex mutex_;
+        std::vector<Hook> hooks_;
+
+    public:
+        void Add(std::string name, std::function<bool()> poll)
+        {
+            std::lock_guard lock(mutex_);
+            hooks_.push_back(Hook{ std::move(name), std::move(poll) });
+        }
+
+        // main loop only; true once every hook is done
+        bool Poll()
+        {
+            std::lock_guard lock(mutex_);
+
+            bool done = true;
+            for (auto & hook : hooks_)
+            {
+                if (!hook.done)
+                    hook.done = hook.poll();
+                done = done && hook.done;
+            }
+
+            return done;
+        }
+
+        [[nodiscard]] std::vector<std::string> Pending()
+        {
+            std::lock_guard lock(mutex_);
+
+            std::vector<std::string> names;
+            for (const auto & hook : hooks_)
+            {
+                if (!hook.done)
+                    names.push_back(hook.name);
+            }
+
+            return names;
+        }
+    };
+
+    inline ShutdownHooks & GetShutdownHooks()
+    {
+        static ShutdownHooks hooks;
+        return hooks;
+    }
+
+    // Jobs from worker threads that must run on the main loop, e.g. anything starting a
+    // Utils::Task (the task manager and the database connector are main-loop only).
+    class MainLoopJobs
+    {
+        std::mutex mutex_;
+        std::vector<std::function<void()>> jobs_;
+        std::vector<std::function<void()>> running_; // main loop only
+
+    public:
+        void Post(std::function<void()> job)
+        {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+
+        // main loop only; jobs posted while running wait for the next call
+        void Run()
+        {
+            {
+                std::lock_guard lock(mutex_);
+                running_.swap(jobs_);
+            }
+
+            for (auto & job : running_)
+            {
+                try
+                {
+                    job();
+                }
+                catch (const std::exception & e)
+                {
+                    Utils::Log()->Error("Main loop job failed: {}", e.what());
+                }
+                catch (...)
+                {
+                    Utils::Log()->Error("Main loop job failed: unknown exception");
+                }
+            }
+            running_.clear();
+        }
+    };
+
+    inline MainLoopJobs & GetMainLoop()
+    {
+        static MainLoopJobs jobs;
+        return jobs;
+    }
+
     using BaseServiceInterface = Utils::Service::BaseServiceInterface;
 
     class BaseServiceContainer: public Utils::Service::BaseServiceContainerTemplate
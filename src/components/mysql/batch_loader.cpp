@@ -0,0 +1,111 @@
+#include "batch_loader.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace Core::Components::MySQL {
+
+    BatchConfig BatchConfig::FromEnv()
+    {
+        BatchConfig config;
+
+        config.maxKeys = static_cast<std::size_t>(std::max(1, Utils::EnvInt("MYSQL_BATCH_SIZE", static_cast<int>(config.maxKeys))));
+        config.window = std::chrono::milliseconds{ std::max(0, Utils::EnvInt("MYSQL_BATCH_WINDOW_MS", 0)) };
+
+        return config;
+    }
+
+    bool BatchLoader::Add(const std::string & select, const std::string & column, Waiter waiter, const Clock::time_point now, Batch & full)
+    {
+        std::lock_guard lock(mutex_);
+
+        const auto [it, opened] = open_.try_emplace(select + '\n' + column);
+        auto & batch = it->second;
+        if (opened)
+        {
+            batch.select = select;
+            batch.column = column;
+            batch.opened = now;
+        }
+
+        batch.waiters.push_back(std::move(waiter));
+        if (batch.waiters.size() < config_.maxKeys)
+            return false;
+
+        full = std::move(batch);
+        open_.erase(it);
+        return true;
+    }
+
+    void BatchLoader::TakeDue(const Clock::time_point now, std::vector<Batch> & due)
+    {
+        std::lock_guard lock(mutex_);
+
+        for (auto it = open_.begin(); it != open_.end(); )
+        {
+            if (now - it->second.opened >= config_.window)
+            {
+                due.push_back(std::move(it->second));
+                it = open_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    std::optional<Interface::BatchKey> BatchLoader::RowKey(const boost::json::value & value)
+    {
+        if (value.is_uint64())
+            return value.get_uint64();
+        if (value.is_int64() && value.get_int64() >= 0)
+            return static_cast<Interface::BatchKey>(value.get_int64());
+
+        // drivers returning every column as text
+        if (value.is_string())
+        {
+            const auto & text = value.get_string();
+            Interface::BatchKey key = 0;
+            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), key);
+            if (ec == std::errc{} && end == text.data() + text.size())
+                return key;
+        }
+
+        return std::nullopt;
+    }
+
+    void BatchLoader::Resolve(Batch & batch, const Interface::RequestResult::Shared & result)
+    {
+        std::unordered_map<Interface::BatchKey, std::size_t> rows;
+
+        if (result && result->IsSuccess())
+        {
+            for (std::size_t i = 0; i < result->Count(); ++i)
+            {
+                const auto * value = result->Get(i).if_contains(batch.column);
+                if (const auto key = value ? RowKey(*value) : std::nullopt)
+                    rows.try_emplace(*key, i);
+            }
+        }
+        else
+        {
+            stats_.failures.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        stats_.latencyNs.fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - batch.opened).count()), std::memory_order_relaxed);
+
+        for (auto & waiter : batch.waiters)
+        {
+            waiter.out->result = result;
+            if (const auto it = rows.find(waiter.key); it != rows.end())
+                waiter.out->index = it->second;
+
+            waiter.resolver->Resolve();
+        }
+    }
+
+} // namespace Core::Components::MySQL
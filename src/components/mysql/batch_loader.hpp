@@ -0,0 +1,108 @@
+#pragma once
+
+#include "interface/connector.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Core::Components::MySQL {
+
+    struct BatchConfig
+    {
+        std::size_t maxKeys = 64;                    // a full batch is sent at once
+        std::chrono::milliseconds window { 0 };     // 0: sent on the next tick
+
+        // MYSQL_BATCH_SIZE, MYSQL_BATCH_WINDOW_MS
+        static BatchConfig FromEnv();
+    };
+
+    // logged by the connector every minute
+    struct BatchStats
+    {
+        std::atomic<uint64_t> batches = 0;
+        std::atomic<uint64_t> full = 0;      // sent before the window closed
+        std::atomic<uint64_t> lookups = 0;   // awaiting Load() calls
+        std::atomic<uint64_t> keys = 0;      // distinct keys sent
+        std::atomic<uint64_t> maxKeys = 0;
+        std::atomic<uint64_t> failures = 0;  // batches whose query failed
+        std::atomic<uint64_t> latencyNs = 0; // first lookup -> result, summed over batches
+
+        void Reset()
+        {
+            batches = 0;
+            full = 0;
+            lookups = 0;
+            keys = 0;
+            maxKeys = 0;
+            failures = 0;
+            latencyNs = 0;
+        }
+    };
+
+    /*
+        Lookups of the same shape (select + key column) collected into one open batch, until it is
+        full or its window closes. Load() may run on any thread, the connector takes due batches
+        on the main loop and resolves them wherever the query finishes.
+    */
+    class BatchLoader
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Waiter
+        {
+            Interface::BatchKey key;
+            Utils::TaskResolver resolver;
+            Interface::LoadedRow * out = nullptr; // in the awaiting coroutine frame
+        };
+
+        struct Batch
+        {
+            std::string select;
+            std::string column;
+            Clock::time_point opened;
+            std::vector<Waiter> waiters;
+        };
+
+    private:
+        BatchConfig config_;
+        BatchStats stats_;
+
+        std::mutex mutex_;
+        std::unordered_map<std::string, Batch> open_; // by select + '\n' + column
+
+    public:
+        void Configure(const BatchConfig & config)
+        {
+            config_ = config;
+        }
+
+        [[nodiscard]] const BatchConfig & Config() const
+        {
+            return config_;
+        }
+
+        [[nodiscard]] BatchStats & Stats()
+        {
+            return stats_;
+        }
+
+        // true if this waiter filled the batch, which is then moved to full
+        bool Add(const std::string & select, const std::string & column, Waiter waiter, Clock::time_point now, Batch & full);
+
+        void TakeDue(Clock::time_point now, std::vector<Batch> & due);
+
+        // the key column of a returned row, exactly; nullopt if it isn't an unsigned integer
+        static std::optional<Interface::BatchKey> RowKey(const boost::json::value & value);
+
+        // hands every waiter its row (or the failure) and resumes it
+        void Resolve(Batch & batch, const Interface::RequestResult::Shared & result);
+    };
+
+} // namespace Core::Components::MySQL
@@ -17,7 +17,10 @@ namespace Core::Components::MySQL {
 
         client_ = Client::Create(config, Log());
 
-        Log()->Debug("MySQL connected");
+        batches_.Configure(BatchConfig::FromEnv());
+
+        Log()->Debug("MySQL connected, lookups batched by {} keys / {}ms",
+                     batches_.Config().maxKeys, batches_.Config().window.count());
     }
 
     void Connector::OnAllServicesLoaded()
@@ -35,6 +38,89 @@ namespace Core::Components::MySQL {
     void Connector::ProcessTick()
     {
         client_->ProcessTick();
+
+        batches_.TakeDue(std::chrono::steady_clock::now(), dueBatches_);
+        for (auto & batch : dueBatches_)
+            RunBatch(std::move(batch));
+        dueBatches_.clear();
+
+        LogBatchStats();
+    }
+
+    Utils::Task<Interface::LoadedRow> Connector::Load(const std::string select, const std::string column, const Interface::BatchKey key)
+    {
+        Interface::LoadedRow row;
+
+        co_await Utils::AwaitablePromiseTask([&, this](const Utils::TaskResolver & resolver)
+        {
+            BatchLoader::Batch full;
+            if (batches_.Add(select, column, { key, resolver, &row }, std::chrono::steady_clock::now(), full))
+            {
+                batches_.Stats().full.fetch_add(1, std::memory_order_relaxed);
+                RunBatch(std::move(full));
+            }
+        });
+
+        co_return row;
+    }
+
+    void Connector::RunBatch(BatchLoader::Batch batch)
+    {
+        auto & stats = batches_.Stats();
+
+        std::string sql = batch.select + " where `" + batch.column + "` in (";
+
+        // a key awaited twice is sent once
+        std::unordered_set<Interface::BatchKey> sent;
+        for (const auto & waiter : batch.waiters)
+        {
+            if (!sent.insert(waiter.key).second)
+                continue;
+
+            if (sent.size() > 1)
+                sql += ", ";
+
+            sql += std::to_string(waiter.key);
+        }
+        sql += ")";
+
+        const uint64_t keys = sent.size();
+        stats.batches.fetch_add(1, std::memory_order_relaxed);
+        stats.lookups.fetch_add(batch.waiters.size(), std::memory_order_relaxed);
+        stats.keys.fetch_add(keys, std::memory_order_relaxed);
+
+        auto max = stats.maxKeys.load(std::memory_order_relaxed);
+        while (keys > max && !stats.maxKeys.compare_exchange_weak(max, keys, std::memory_order_relaxed)) {}
+
+        Query(sql) = [this, batch = std::make_shared<BatchLoader::Batch>(std::move(batch))](const Interface::RequestResult::Shared & result)
+        {
+            batches_.Resolve(*batch, result);
+        };
+    }
+
+    void Connector::LogBatchStats()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration<double>(now - statsSince_).count();
+        if (elapsed < 60.0)
+            return;
+
+        auto & stats = batches_.Stats();
+        if (const uint64_t batches = stats.batches)
+        {
+            const uint64_t lookups = stats.lookups;
+
+            Log()->Debug("[MySQL] batches={} lookups={} ({:.1f}/batch) keys={} (max {}) full={} failures={} latency={:.2f}ms/batch",
+                         batches,
+                         lookups, static_cast<double>(lookups) / static_cast<double>(batches),
+                         stats.keys.load(), stats.maxKeys.load(),
+                         stats.full.load(),
+                         stats.failures.load(),
+                         static_cast<double>(stats.latencyNs) / 1e6 / static_cast<double>(batches));
+        }
+
+        stats.Reset();
+        statsSince_ = now;
     }
 
     Utils::Task<Interface::RequestResult::Shared> Connector::Query(const std::string & query)
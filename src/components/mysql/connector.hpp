@@ -1,9 +1,12 @@
 #pragma once
 
 #include "interface/connector.hpp"
+#include "batch_loader.hpp"
 
 #include "mysql.hpp"
 
+#include <unordered_set>
+
 namespace Core::Components::MySQL {
     using namespace Utils::DB::MySQL;
 
@@ -48,6 +51,14 @@ namespace Core::Components::MySQL {
     {
         Utils::DB::MySQL::Client::Shared client_;
 
+        BatchLoader batches_;
+        std::vector<BatchLoader::Batch> dueBatches_; // main loop only
+        std::chrono::steady_clock::time_point statsSince_ = std::chrono::steady_clock::now();
+
+        void RunBatch(BatchLoader::Batch batch);
+
+        void LogBatchStats();
+
     public:
         using Shared    = std::shared_ptr<Connector>;
 
@@ -56,6 +67,8 @@ namespace Core::Components::MySQL {
 
         Utils::Task<Interface::RequestResult::Shared> Query(const std::string & query) override;
 
+        Utils::Task<Interface::LoadedRow> Load(std::string select, std::string column, Interface::BatchKey key) override;
+
         std::string EscapeString(const std::string& s) override;
     protected:
         void Initialise() override;
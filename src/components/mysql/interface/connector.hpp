@@ -2,9 +2,11 @@
 
 #include "[core_loader].hpp"
 #include "coroutine.hpp"
+#include "row.hpp"
 
 #include <boost/json.hpp>
 #include <array>
+#include <optional>
 #include <string>
 #include <type_traits>
 
@@ -27,6 +29,38 @@ namespace Core::Components::MySQL {
             [[nodiscard]] virtual size_t Count() const = 0;
 
             [[nodiscard]] virtual uint64_t InsertID() const = 0;
+
+            // typed access to row n, see Row
+            [[nodiscard]] Row At(const size_t n)
+            {
+                return Row(Get(n));
+            }
+        };
+
+        // key of a batched lookup, see Connector::Load. Numeric only: text keys compare by the column
+        // collation (case, accents, trailing spaces), which the rows can't be matched back to reliably
+        using BatchKey = uint64_t;
+
+        // the row a batched lookup resolved to; the batch result keeps it alive
+        struct LoadedRow
+        {
+            RequestResult::Shared result;     // null or not successful: the batch query failed
+            std::optional<std::size_t> index; // row of result matching the key
+
+            [[nodiscard]] bool IsSuccess() const
+            {
+                return result && result->IsSuccess();
+            }
+
+            [[nodiscard]] bool Found() const
+            {
+                return IsSuccess() && index.has_value();
+            }
+
+            [[nodiscard]] Row Get() const
+            {
+                return result->At(*index);
+            }
         };
 
         class Connector : public BaseServiceInterface
@@ -39,6 +73,11 @@ namespace Core::Components::MySQL {
             // Базовый "сыро-строковый" запрос — реализуется в имплементации
             virtual Utils::Task<RequestResult::Shared> Query(const std::string & query) = 0;
 
+            // a lookup by one numeric key column, merged with concurrent lookups of the same shape into
+            // "<select> where `column` in (...)"; select has to return the column,
+            // e.g. Load("select id, experience from `snake_players`", "id", userID)
+            virtual Utils::Task<LoadedRow> Load(std::string select, std::string column, BatchKey key) = 0;
+
         protected:
             // Реализация escape — делает конкретный MySQL-клиент
             virtual std::string EscapeString(const std::string & s) = 0;
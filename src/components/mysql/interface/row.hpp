@@ -0,0 +1,146 @@
+#pragma once
+
+#include <boost/json.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace Core::Components::MySQL {
+    namespace Interface {
+
+        /*
+            Typed view of one result row. Columns are addressed by index (select order) or name;
+            text-protocol numbers are converted in place with from_chars, strings are views into
+            the result, which has to outlive them.
+        */
+        class Row
+        {
+            const boost::json::object * object_;
+
+            template<typename T>
+            static T Convert(const boost::json::value & value, const std::string_view column)
+            {
+                using Decayed = std::remove_cvref_t<T>;
+
+                if constexpr (std::is_same_v<Decayed, std::string_view>)
+                {
+                    if (!value.is_string())
+                        throw std::runtime_error(std::string("SQL column '") + std::string(column) + "' is not text");
+                    return value.get_string();
+                }
+                else if constexpr (std::is_same_v<Decayed, std::string>)
+                {
+                    return std::string(Convert<std::string_view>(value, column));
+                }
+                else if constexpr (std::is_arithmetic_v<Decayed>)
+                {
+                    if (value.is_null())
+                        return Decayed{};
+
+                    if constexpr (std::is_same_v<Decayed, bool>)
+                    {
+                        if (value.is_bool())
+                            return value.get_bool();
+                        return Convert<int64_t>(value, column) != 0;
+                    }
+                    else
+                    {
+                        if (value.is_string())
+                        {
+                            const std::string_view text = value.get_string();
+
+                            Decayed result{};
+                            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), result);
+                            if (ec != std::errc{} || end != text.data() + text.size())
+                                throw std::runtime_error(std::string("SQL column '") + std::string(column) + "' is not a number");
+                            return result;
+                        }
+
+                        boost::system::error_code ec;
+                        const auto result = value.to_number<Decayed>(ec);
+                        if (ec)
+                            throw std::runtime_error(std::string("SQL column '") + std::string(column) + "' does not fit");
+                        return result;
+                    }
+                }
+                else
+                {
+                    static_assert(!sizeof(T), "Unsupported SQL column type");
+                }
+            }
+
+        public:
+            explicit Row(const boost::json::object & object): object_(&object) {}
+
+            [[nodiscard]] std::size_t Size() const
+            {
+                return object_->size();
+            }
+
+            [[nodiscard]] bool IsNull(const std::size_t index) const
+            {
+                return At(index).value().is_null();
+            }
+
+            template<typename T>
+            [[nodiscard]] T Get(const std::size_t index) const
+            {
+                const auto & column = At(index);
+                return Convert<T>(column.value(), column.key());
+            }
+
+            template<typename T>
+            [[nodiscard]] T Get(const std::string_view column) const
+            {
+                const auto * value = object_->if_contains(column);
+                if (value == nullptr)
+                    throw std::runtime_error(std::string("SQL column '") + std::string(column) + "' not in result");
+                return Convert<T>(*value, column);
+            }
+
+            template<typename T>
+            [[nodiscard]] std::optional<T> Find(const std::string_view column) const
+            {
+                const auto * value = object_->if_contains(column);
+                if (value == nullptr || value->is_null())
+                    return std::nullopt;
+                return Convert<T>(*value, column);
+            }
+
+            // the first sizeof...(Ts) columns, e.g. auto [id, experience] = row.As<uint32_t, uint32_t>()
+            template<typename... Ts>
+            [[nodiscard]] std::tuple<Ts...> As() const
+            {
+                return [this]<std::size_t... I>(std::index_sequence<I...>)
+                {
+                    return std::tuple<Ts...>{ Get<Ts>(I)... };
+                }(std::index_sequence_for<Ts...>{});
+            }
+
+            // columns in select order into the given members
+            template<typename Struct, typename... Members>
+            [[nodiscard]] Struct Into(Members Struct::*... members) const
+            {
+                Struct result{};
+                std::size_t index = 0;
+                ((result.*members = Get<std::remove_cvref_t<Members>>(index++)), ...);
+                return result;
+            }
+
+        private:
+            [[nodiscard]] const boost::json::key_value_pair & At(const std::size_t index) const
+            {
+                if (index >= object_->size())
+                    throw std::runtime_error("SQL column index " + std::to_string(index) + " out of range");
+                return *(object_->begin() + index);
+            }
+        };
+
+    } // namespace Interface
+} // namespace Core::Components::MySQL
@@ -5,71 +5,209 @@
 #include <utility>
 #include <websocket.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "message.hpp"
+#include "msgpack.hpp"
+#include "parse_arena.hpp"
+#include "protocol.hpp"
+#include "timer_wheel.hpp"
+#include "worker_pool.hpp"
 
 namespace Core::Servers::Websocket {
     namespace Net = Utils::Net::Websocket;
 
+    class Client;
+
+    // Request() timeout, owned by the service wheel
+    struct JobTimer
+    {
+        std::weak_ptr<Client> client;
+        uint64_t jobID = 0;
+    };
+
+    // the wheel behind a lock: clients schedule from worker strands, the service expires on the main loop
+    class JobTimers
+    {
+        std::mutex mutex_;
+        TimerWheel<JobTimer> wheel_;
+
+    public:
+        void Schedule(const TimerWheel<JobTimer>::Clock::time_point at, JobTimer timer)
+        {
+            std::lock_guard lock(mutex_);
+            wheel_.Schedule(at, std::move(timer));
+        }
+
+        // collected under the lock, expired by the caller without it
+        void Advance(const TimerWheel<JobTimer>::Clock::time_point now, std::vector<JobTimer> & due)
+        {
+            std::lock_guard lock(mutex_);
+            wheel_.Advance(now, [&due](JobTimer & timer) { due.push_back(std::move(timer)); });
+        }
+
+        [[nodiscard]] std::size_t Size()
+        {
+            std::lock_guard lock(mutex_);
+            return wheel_.Size();
+        }
+    };
+
+    // service-owned state shared by all of its clients
+    struct ClientContext
+    {
+        const MessageTypes * types = nullptr;
+        ProtocolStats * stats = nullptr;
+        JobTimers * timers = nullptr;
+        WorkerPool * workers = nullptr;
+        std::size_t parseArenaBytes = 0; // 0: messages use the default allocator
+    };
+
     class Client final :
         public Interface::Client,
         public std::enable_shared_from_this<Client>
     {
         Net::Session::Shared session_;
-        bool connected_ = true;
+        std::atomic<bool> connected_ = true;
+
+        std::atomic<Protocol> protocol_ = Protocol::Json;
+        const MessageTypes * types_ = nullptr; // owned by the server
+        ProtocolStats * stats_ = nullptr;
+        JobTimers * timers_ = nullptr;
+
+        // every event of this client (connect, messages, disconnect) runs here, in arrival order
+        Strand::Shared strand_;
+
+        // strand only: the parser keeps its scratch stack between messages, bodies go into pooled arenas
+        boost::json::parser parser_;
+        ParseArenaPool::Shared arenas_;
 
         struct JobHandler
         {
             std::chrono::steady_clock::time_point expireAt;
             MessageCallback callback;
         };
+        std::mutex jobsMutex_;
         std::unordered_map<uint64_t, JobHandler> jobsHandlers_;
 
-        uint64_t sourceJobID_ = 1;
+        std::atomic<uint64_t> sourceJobID_ = 1;
     public:
         using Shared    = std::shared_ptr<Client>;
 
-        explicit Client(Net::Session::Shared session): session_(std::move(session)) {}
+        Client(Net::Session::Shared session, const ClientContext & context):
+        session_(std::move(session)), types_(context.types), stats_(context.stats), timers_(context.timers),
+        strand_(Strand::Create(*context.workers)),
+        arenas_(context.parseArenaBytes ? ParseArenaPool::Create(context.parseArenaBytes, 4) : nullptr) {}
+
+        [[nodiscard]] const Strand::Shared & GetStrand() const
+        {
+            return strand_;
+        }
+
+        void Post(std::function<void()> job) override
+        {
+            strand_->Post(std::move(job));
+        }
+
+        // strand only
+        [[nodiscard]] ParseLease AcquireArena()
+        {
+            return arenas_ ? arenas_->Acquire() : ParseLease{};
+        }
+
+        // strand only; the value is allocated from storage
+        boost::json::value ParseJson(const std::string_view text, const boost::json::storage_ptr & storage, boost::system::error_code & ec)
+        {
+            parser_.reset(storage);
+            parser_.write(text, ec);
+
+            boost::json::value value = ec ? boost::json::value(nullptr) : parser_.release();
+
+            // the parser would hold its reference to the arena until the next message
+            parser_.reset();
+            return value;
+        }
 
         bool IsConnected() const override
         {
             return connected_;
         }
 
+        [[nodiscard]] Protocol GetProtocol() const
+        {
+            return protocol_;
+        }
+
+        void SetProtocol(const Protocol protocol)
+        {
+            protocol_ = protocol;
+        }
+
         void OnMessage(const Message::Shared & message)
         {
-            if (const auto targetJobID = message->GetHeaders()->GetTargetJobID(); jobsHandlers_.contains(targetJobID))
+            MessageCallback callback;
             {
-                jobsHandlers_[targetJobID].callback(message);
-                jobsHandlers_.erase(targetJobID);
+                std::lock_guard lock(jobsMutex_);
+                const auto it = jobsHandlers_.find(message->GetHeaders().GetTargetJobID());
+                if (it == jobsHandlers_.end())
+                    return;
+
+                callback = std::move(it->second.callback);
+                jobsHandlers_.erase(it);
             }
+
+            callback(message);
         }
 
         uint64_t Send(const std::string & type, const boost::json::object & body, uint64_t targetJobID = 0) override
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            if (protocol_ == Protocol::Binary)
+            {
+                std::vector<uint8_t> packed;
+                EncodeMsgPack(body, packed);
+
+                const auto size = packed.size();
+                const auto sourceJobID = SendPacked(type, packed, targetJobID);
+                CountSerialized(size, start);
+                return sourceJobID;
+            }
+
+            // the body is serialized once, the envelope is spliced around it
+            const auto serialized = boost::json::serialize(body);
+            const auto sourceJobID = SendSerialized(type, serialized, targetJobID);
+            CountSerialized(serialized.size(), start);
+            return sourceJobID;
+        }
+
+        uint64_t SendSerialized(const std::string & type, const std::string_view body, const uint64_t targetJobID = 0) override
+        {
+            return SendPrepared(Interface::PreparedMessage(type, body), targetJobID);
+        }
+
+        uint64_t SendPrepared(const Interface::PreparedMessage & message, const uint64_t targetJobID = 0) override
         {
             if (!IsConnected())
             {
-                Log()->Warning("Send in disconnected state!");
+                Log()->Warning("SendPrepared in disconnected state!");
                 return 0;
             }
 
-            const auto sourceJobID = sourceJobID_++;
-
-            boost::json::object headers = {
-                {"sourceJobId", sourceJobID},
-                {"targetJobId", targetJobID},
-            };
+            if (protocol_ == Protocol::Binary)
+                return SendPacked(message.GetType(), message.Packed(), targetJobID);
 
-            boost::json::object message = {
-                {"type", type},
-                {"headers", headers},
-                {"message", body},
-            };
+            const auto sourceJobID = sourceJobID_++;
 
-            session_->Send(message);
+            // same envelope as Send(), without building and serializing the body again
+            session_->Send(message.Render(sourceJobID, targetJobID));
 
             return sourceJobID;
         }
@@ -104,12 +242,44 @@ namespace Core::Servers::Websocket {
 
         void RegisterJobCallback(const uint64_t jobID, const MessageCallback & callback, const uint64_t timeout)
         {
-            const auto now = std::chrono::steady_clock::now();
+            const auto expireAt = std::chrono::steady_clock::now() + std::chrono::milliseconds{ timeout };
+
+            {
+                std::lock_guard lock(jobsMutex_);
+                jobsHandlers_[jobID] = JobHandler{
+                    .expireAt = expireAt,
+                    .callback = callback
+                };
+            }
 
-            jobsHandlers_[jobID] = JobHandler{
-                .expireAt = now + std::chrono::milliseconds{ timeout },
-                .callback = callback
-            };
+            if (timers_)
+                timers_->Schedule(expireAt, JobTimer{ weak_from_this(), jobID });
+        }
+
+        // called by the service wheel; the job may have been answered meanwhile. True if it timed out
+        bool ExpireJob(const uint64_t jobID)
+        {
+            MessageCallback callback;
+            {
+                std::lock_guard lock(jobsMutex_);
+                const auto it = jobsHandlers_.find(jobID);
+                if (it == jobsHandlers_.end())
+                    return false;
+
+                // clamped far deadline: not due yet, go around again
+                if (const auto now = std::chrono::steady_clock::now(); it->second.expireAt > now)
+                {
+                    if (timers_)
+                        timers_->Schedule(it->second.expireAt, JobTimer{ weak_from_this(), jobID });
+                    return false;
+                }
+
+                callback = std::move(it->second.callback);
+                jobsHandlers_.erase(it);
+            }
+
+            callback({});
+            return true;
         }
 
         void Close()
@@ -128,42 +298,73 @@ namespace Core::Servers::Websocket {
             session_->Close();
         }
 
-        void ProcessTick()
-        {
-            const auto now = std::chrono::steady_clock::now();
-            ClearJobHandlers(now);
-        }
-
         void ClearJobHandlers(const std::chrono::steady_clock::time_point & time = std::chrono::steady_clock::time_point::max())
         {
-            for (auto it = jobsHandlers_.begin(); it != jobsHandlers_.end(); )
+            std::vector<MessageCallback> expired;
             {
-                if (it->second.expireAt <= time)
+                std::lock_guard lock(jobsMutex_);
+                for (auto it = jobsHandlers_.begin(); it != jobsHandlers_.end(); )
                 {
-                    auto callback = std::move(it->second.callback);
-
-                    it = jobsHandlers_.erase(it);
-
-                    callback({});
-                }
-                else
-                {
-                    ++it;
+                    if (it->second.expireAt <= time)
+                    {
+                        expired.push_back(std::move(it->second.callback));
+                        it = jobsHandlers_.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
                 }
             }
+
+            // outside the lock, a callback may register the next job
+            for (const auto & callback : expired)
+                callback({});
         }
 
 
     private:
+        // binary envelope + MessagePack body, see protocol.hpp
+        uint64_t SendPacked(const std::string & type, const std::vector<uint8_t> & body, const uint64_t targetJobID)
+        {
+            if (!IsConnected())
+            {
+                Log()->Warning("SendPacked in disconnected state!");
+                return 0;
+            }
+
+            const auto sourceJobID = sourceJobID_++;
+
+            const auto typeID = types_ ? types_->Find(type) : 0;
+
+            std::vector<uint8_t> frame;
+            frame.reserve(body.size() + (typeID ? 24 : 24 + type.size()));
+            EncodeBinaryEnvelope(frame, typeID, type, sourceJobID, targetJobID);
+            frame.insert(frame.end(), body.begin(), body.end());
+
+            session_->Send(std::move(frame));
+
+            return sourceJobID;
+        }
+
+        void CountSerialized(const std::size_t size, const std::chrono::steady_clock::time_point start) const
+        {
+            if (!stats_)
+                return;
+
+            stats_->Serialized(protocol_).Add(size, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        }
+
         std::string GetServiceContainerName() const override
         {
             return std::format("{}:{}", session_->RemoteAddress(), session_->RemotePort());
         }
 
     public:
-        static Shared Create(const BaseServiceContainer * parent, const Net::Session::Shared & session)
+        static Shared Create(const BaseServiceContainer * parent, const Net::Session::Shared & session, const ClientContext & context)
         {
-            const auto obj = std::make_shared<Client>(session);
+            const auto obj = std::make_shared<Client>(session, context);
             obj->SetupContainer(parent);
             return obj;
         }
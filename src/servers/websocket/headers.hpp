@@ -2,62 +2,28 @@
 
 #include "interfaces/server.hpp"
 
-#include <utility>
-#include <websocket.hpp>
-
-#include <memory>
-#include <string>
-
 namespace Core::Servers::Websocket {
-    namespace Net = Utils::Net::Websocket;
+    using Headers = Interface::Headers;
 
-    class Headers final :
-        public Interface::Headers,
-        public std::enable_shared_from_this<Headers>
+    // {"sourceJobId", "targetJobId"}, missing or non-integer ids are 0
+    inline Headers ParseHeaders(const boost::json::object & body)
     {
         uint64_t sourceJobID = 0;
         uint64_t targetJobID = 0;
-    public:
-        using Shared    = std::shared_ptr<Headers>;
-
-        explicit Headers(const boost::json::object & body)
-        {
-            const boost::json::value * v = nullptr;
-
-            v = body.if_contains("sourceJobId");
-            if (v != nullptr && v->is_int64()) {
-                sourceJobID = v->as_int64();
-            }
-
-            v = body.if_contains("targetJobId");
-            if (v != nullptr && v->is_int64()) {
-                targetJobID = v->as_int64();
-            }
-        }
 
-        uint64_t GetSourceJobID() const override
-        {
-            return sourceJobID;
-        }
+        const boost::json::value * v = nullptr;
 
-        uint64_t GetTargetJobID() const override
-        {
-            return targetJobID;
+        v = body.if_contains("sourceJobId");
+        if (v != nullptr && v->is_int64()) {
+            sourceJobID = v->as_int64();
         }
 
-    private:
-        std::string GetServiceContainerName() const override
-        {
-            return "Headers";
+        v = body.if_contains("targetJobId");
+        if (v != nullptr && v->is_int64()) {
+            targetJobID = v->as_int64();
         }
 
-    public:
-        static Shared Create(const BaseServiceContainer * parent, const boost::json::object &body)
-        {
-            const auto obj = std::make_shared<Headers>(body);
-            obj->SetupContainer(parent);
-            return obj;
-        }
-    };
+        return { sourceJobID, targetJobID };
+    }
 
 } // namespace Core::Servers::Websocket
\ No newline at end of file
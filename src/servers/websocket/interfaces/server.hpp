@@ -4,20 +4,35 @@
 
 #include <boost/json.hpp>
 
+#include <charconv>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
 #include "coroutine.hpp"
+#include "servers/websocket/msgpack.hpp"
 
 namespace Core::Servers::Websocket {
     namespace Interface {
-        class Headers: public BaseServiceContainer
+        // plain value, stored inline in every message
+        class Headers
         {
+            uint64_t sourceJobID_ = 0;
+            uint64_t targetJobID_ = 0;
         public:
-            using Shared = std::shared_ptr<Headers>;
+            Headers() = default;
 
-            ~Headers() override = default;
+            Headers(const uint64_t sourceJobID, const uint64_t targetJobID): sourceJobID_(sourceJobID), targetJobID_(targetJobID) {}
 
-            [[nodiscard]] virtual uint64_t GetSourceJobID() const = 0;
+            [[nodiscard]] uint64_t GetSourceJobID() const
+            {
+                return sourceJobID_;
+            }
 
-            [[nodiscard]] virtual uint64_t GetTargetJobID() const = 0;
+            [[nodiscard]] uint64_t GetTargetJobID() const
+            {
+                return targetJobID_;
+            }
         };
 
         class Message: public BaseServiceContainer
@@ -27,15 +42,105 @@ namespace Core::Servers::Websocket {
 
             ~Message() override = default;
 
-            [[nodiscard]] virtual Headers::Shared GetHeaders() const = 0;
+            [[nodiscard]] virtual const Headers & GetHeaders() const = 0;
 
             [[nodiscard]] virtual const std::string & GetType() const = 0;
 
+            // interned at RegisterMessage, 0 for types nobody registered
+            [[nodiscard]] virtual uint32_t GetTypeID() const = 0;
+
             [[nodiscard]] virtual boost::json::object & GetBody() = 0;
 
             [[nodiscard]] virtual std::string ToString() const = 0;
         };
 
+        // {"type", "headers", "message"} envelope serialized once for any number of recipients.
+        // Immutable and shared; only the job IDs are written per recipient.
+        // Binary protocol clients get the body packed as MessagePack, also once per message.
+        // Net::Session::Send takes one owned, contiguous frame, so Render still copies the body per
+        // recipient; a session accepting a shared buffer plus a per-recipient prefix would remove it.
+        class PreparedMessage
+        {
+            static constexpr std::string_view bodyKey = R"(},"message":)";
+
+            std::string type_;
+            std::string head_; // {"type":...,"headers":{"sourceJobId":
+            std::string tail_; // }},"message":<body>}
+
+            mutable std::once_flag packedOnce_;
+            mutable std::vector<uint8_t> packed_;
+
+        public:
+            using Shared = std::shared_ptr<const PreparedMessage>;
+
+            PreparedMessage(const std::string & type, const std::string_view body): type_(type)
+            {
+                head_ = R"({"type":)";
+                head_ += boost::json::serialize(boost::json::string_view(type));
+                head_ += R"(,"headers":{"sourceJobId":)";
+
+                tail_.reserve(body.size() + 16);
+                tail_ = bodyKey;
+                tail_ += body;
+                tail_ += '}';
+            }
+
+            // the frame handed to Net::Session::Send, which keeps it until written
+            [[nodiscard]] std::string Render(const uint64_t sourceJobID, const uint64_t targetJobID) const
+            {
+                constexpr std::string_view targetKey = R"(,"targetJobId":)";
+
+                char source[20];
+                char target[20];
+                const auto sourceEnd = std::to_chars(std::begin(source), std::end(source), sourceJobID).ptr;
+                const auto targetEnd = std::to_chars(std::begin(target), std::end(target), targetJobID).ptr;
+
+                std::string out;
+                out.reserve(head_.size() + tail_.size() + targetKey.size() + 40);
+                out.append(head_);
+                out.append(source, sourceEnd);
+                out.append(targetKey);
+                out.append(target, targetEnd);
+                out.append(tail_);
+                return out;
+            }
+
+            [[nodiscard]] const std::string & GetType() const
+            {
+                return type_;
+            }
+
+            // serialized JSON body
+            [[nodiscard]] std::string_view Body() const
+            {
+                return std::string_view(tail_).substr(bodyKey.size(), tail_.size() - bodyKey.size() - 1);
+            }
+
+            // MessagePack body, packed by the first binary recipient
+            [[nodiscard]] const std::vector<uint8_t> & Packed() const
+            {
+                std::call_once(packedOnce_, [this]
+                {
+                    boost::system::error_code ec;
+                    const auto body = boost::json::parse(Body(), ec);
+                    EncodeMsgPack(ec ? boost::json::value(boost::json::object{}) : body, packed_);
+                });
+
+                return packed_;
+            }
+
+            // body is an already serialized JSON object
+            static Shared Create(const std::string & type, const std::string_view body)
+            {
+                return std::make_shared<const PreparedMessage>(type, body);
+            }
+
+            static Shared Create(const std::string & type, const boost::json::object & body)
+            {
+                return Create(type, boost::json::serialize(body));
+            }
+        };
+
         class Client: public BaseServiceContainer
         {
         public:
@@ -54,8 +159,15 @@ namespace Core::Servers::Websocket {
 
             virtual uint64_t Send(const std::string & type, const boost::json::object & body, uint64_t targetJobID = 0) = 0;
 
+            // body is an already serialized JSON object, spliced into the envelope as is
+            virtual uint64_t SendSerialized(const std::string & type, std::string_view body, uint64_t targetJobID = 0) = 0;
+
+            virtual uint64_t SendPrepared(const PreparedMessage & message, uint64_t targetJobID = 0) = 0;
+
             virtual Utils::Task<Message::Shared> Request(const std::string & type, const boost::json::object & body, uint64_t timeout = 5000) = 0;
 
+            // runs the job on the client's strand, after every message already queued there
+            virtual void Post(std::function<void()> job) = 0;
         };
 
         class Server: public BaseServiceInterface
@@ -70,6 +182,19 @@ namespace Core::Servers::Websocket {
 
             using ClientCallback = std::function<void(const Client::Shared &, const Client::Events &)>;
             virtual void RegisterClientsCallback(const ClientCallback & callback) = 0;
+
+            // topics are dropped for a client when it disconnects
+            virtual void Subscribe(const std::string & topic, const Client::Shared & client) = 0;
+
+            virtual void Unsubscribe(const std::string & topic, const Client::Shared & client) = 0;
+
+            // body is an already serialized JSON object, the same bytes go to every subscriber
+            virtual void Publish(const std::string & topic, const std::string & type, std::string_view body) = 0;
+
+            // serialized once for all recipients, see PreparedMessage
+            virtual void Broadcast(const PreparedMessage::Shared & message, const std::vector<Client::Shared> & recipients) = 0;
+
+            virtual void Broadcast(const std::string & type, const boost::json::object & body, const std::vector<Client::Shared> & recipients) = 0;
         };
     }
 }
@@ -2,6 +2,7 @@
 
 #include "interfaces/server.hpp"
 #include "headers.hpp"
+#include "parse_arena.hpp"
 
 #include <utility>
 #include <websocket.hpp>
@@ -16,23 +17,56 @@ namespace Core::Servers::Websocket {
         public Interface::Message,
         public std::enable_shared_from_this<Message>
     {
-        Headers::Shared headers_;
-        std::string type_;
+        const BaseServiceContainer * parent_ = nullptr;
+        mutable Utils::Logging::Logger::Shared logger_ {};
+
+        Headers headers_;
+        uint32_t typeID_ = 0;
+        const std::string * type_ = nullptr; // the interned name, or ownedType_
+        std::string ownedType_;
+        ParseLease lease_; // storage of body_ when parsed into a client arena
         boost::json::object body_;
     public:
         using Shared    = std::shared_ptr<Message>;
 
-        Message(Headers::Shared headers, std::string type, boost::json::object body):
-        headers_(std::move(headers)), type_(std::move(type)), body_(std::move(body)) {}
+        // Registered type: no copy of the name. The body is moved, with a lease it keeps pointing into the arena.
+        // The arena storage is ref-counted: a value copied out of the body (e.g. body["x"] kept in a player)
+        // holds the arena too, so it stays valid after the message; the arena is reused once the last copy is gone.
+        // Copy with an explicit default storage_ptr to let the arena go back to the pool right away.
+        Message(const BaseServiceContainer * parent, const Headers headers, const uint32_t typeID, const std::string & type, boost::json::object && body, ParseLease lease = {}):
+        parent_(parent), headers_(headers), typeID_(typeID), type_(&type), lease_(std::move(lease)), body_(std::move(body)) {}
+
+        Message(const BaseServiceContainer * parent, const Headers headers, std::string type, boost::json::object && body, ParseLease lease = {}):
+        parent_(parent), headers_(headers), ownedType_(std::move(type)), lease_(std::move(lease)), body_(std::move(body))
+        {
+            type_ = &ownedType_;
+        }
+
+        Message(const Message &) = delete;
+        Message & operator=(const Message &) = delete;
 
-        Interface::Headers::Shared GetHeaders() const override
+        // most messages never log: the child logger is created on first use instead of per message
+        const Utils::Logging::Logger::Shared & Log() const override
+        {
+            if (!logger_)
+                logger_ = parent_ ? parent_->Log()->CreateChild(GetServiceContainerName()) : BaseServiceContainer::Log();
+
+            return logger_;
+        }
+
+        const Headers & GetHeaders() const override
         {
             return headers_;
         }
 
         const std::string & GetType() const override
         {
-            return type_;
+            return *type_;
+        }
+
+        uint32_t GetTypeID() const override
+        {
+            return typeID_;
         }
 
         boost::json::object & GetBody() override
@@ -48,15 +82,21 @@ namespace Core::Servers::Websocket {
     private:
         std::string GetServiceContainerName() const override
         {
-            return type_;
+            return *type_;
         }
 
     public:
-        static Shared Create(const BaseServiceContainer * parent, const Headers::Shared & headers, const std::string & type, const boost::json::object &body)
+        // parent and the interned type name must outlive the message
+        static Shared Create(const BaseServiceContainer * parent, const Headers headers, const uint32_t typeID, const std::string & type,
+                             boost::json::object && body, ParseLease lease = {})
+        {
+            return std::make_shared<Message>(parent, headers, typeID, type, std::move(body), std::move(lease));
+        }
+
+        static Shared Create(const BaseServiceContainer * parent, const Headers headers, std::string type,
+                             boost::json::object && body, ParseLease lease = {})
         {
-            const auto obj = std::make_shared<Message>(headers, type, body);
-            obj->SetupContainer(parent);
-            return obj;
+            return std::make_shared<Message>(parent, headers, std::move(type), std::move(body), std::move(lease));
         }
 
         static Shared Impl(const Interface::Message::Shared & session)
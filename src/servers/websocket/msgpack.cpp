@@ -0,0 +1,293 @@
+#include "servers/websocket/msgpack.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace Core::Servers::Websocket {
+
+    namespace
+    {
+        constexpr std::size_t MaxDepth = 64;
+
+        template<typename T>
+        void WriteBE(std::vector<uint8_t> & out, const T value)
+        {
+            for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8)
+                out.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> shift));
+        }
+
+        template<typename T>
+        bool ReadBE(const std::span<const uint8_t> data, std::size_t & offset, T & value)
+        {
+            if (data.size() - offset < sizeof(T))
+                return false;
+
+            uint64_t v = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+                v = (v << 8) | data[offset + i];
+
+            offset += sizeof(T);
+            value = static_cast<T>(v);
+            return true;
+        }
+
+        void WriteString(std::vector<uint8_t> & out, const std::string_view s)
+        {
+            if (s.size() < 32)
+                out.push_back(static_cast<uint8_t>(0xA0 | s.size()));
+            else if (s.size() <= 0xFF)
+            {
+                out.push_back(0xD9);
+                out.push_back(static_cast<uint8_t>(s.size()));
+            }
+            else if (s.size() <= 0xFFFF)
+            {
+                out.push_back(0xDA);
+                WriteBE<uint16_t>(out, static_cast<uint16_t>(s.size()));
+            }
+            else
+            {
+                out.push_back(0xDB);
+                WriteBE<uint32_t>(out, static_cast<uint32_t>(s.size()));
+            }
+
+            out.insert(out.end(), s.begin(), s.end());
+        }
+
+        void WriteContainer(std::vector<uint8_t> & out, const std::size_t size, const uint8_t fix, const uint8_t tag16)
+        {
+            if (size < 16)
+                out.push_back(static_cast<uint8_t>(fix | size));
+            else if (size <= 0xFFFF)
+            {
+                out.push_back(tag16);
+                WriteBE<uint16_t>(out, static_cast<uint16_t>(size));
+            }
+            else
+            {
+                out.push_back(static_cast<uint8_t>(tag16 + 1));
+                WriteBE<uint32_t>(out, static_cast<uint32_t>(size));
+            }
+        }
+
+        void WriteInt(std::vector<uint8_t> & out, const int64_t v)
+        {
+            if (v >= 0)
+            {
+                const auto u = static_cast<uint64_t>(v);
+                if (u <= 0x7F)
+                    out.push_back(static_cast<uint8_t>(u));
+                else if (u <= 0xFF)
+                {
+                    out.push_back(0xCC);
+                    out.push_back(static_cast<uint8_t>(u));
+                }
+                else if (u <= 0xFFFF)
+                {
+                    out.push_back(0xCD);
+                    WriteBE<uint16_t>(out, static_cast<uint16_t>(u));
+                }
+                else if (u <= 0xFFFFFFFF)
+                {
+                    out.push_back(0xCE);
+                    WriteBE<uint32_t>(out, static_cast<uint32_t>(u));
+                }
+                else
+                {
+                    out.push_back(0xCF);
+                    WriteBE<uint64_t>(out, u);
+                }
+                return;
+            }
+
+            if (v >= -32)
+                out.push_back(static_cast<uint8_t>(v));
+            else if (v >= INT8_MIN)
+            {
+                out.push_back(0xD0);
+                out.push_back(static_cast<uint8_t>(v));
+            }
+            else if (v >= INT16_MIN)
+            {
+                out.push_back(0xD1);
+                WriteBE<uint16_t>(out, static_cast<uint16_t>(v));
+            }
+            else if (v >= INT32_MIN)
+            {
+                out.push_back(0xD2);
+                WriteBE<uint32_t>(out, static_cast<uint32_t>(v));
+            }
+            else
+            {
+                out.push_back(0xD3);
+                WriteBE<uint64_t>(out, static_cast<uint64_t>(v));
+            }
+        }
+
+        bool ReadString(const std::span<const uint8_t> data, std::size_t & offset, const std::size_t size, boost::json::value & out)
+        {
+            if (data.size() - offset < size)
+                return false;
+
+            // allocated from out's storage, like every container below
+            out = boost::json::string_view(reinterpret_cast<const char *>(data.data() + offset), size);
+            offset += size;
+            return true;
+        }
+
+        bool Decode(std::span<const uint8_t> data, std::size_t & offset, boost::json::value & out, std::size_t depth);
+
+        bool ReadArray(const std::span<const uint8_t> data, std::size_t & offset, const std::size_t size, boost::json::value & out, const std::size_t depth)
+        {
+            // every element takes at least one byte
+            if (data.size() - offset < size)
+                return false;
+
+            auto & array = out.emplace_array();
+            array.reserve(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                if (!Decode(data, offset, array.emplace_back(nullptr), depth + 1))
+                    return false;
+            }
+            return true;
+        }
+
+        bool ReadMap(const std::span<const uint8_t> data, std::size_t & offset, const std::size_t size, boost::json::value & out, const std::size_t depth)
+        {
+            if ((data.size() - offset) / 2 < size)
+                return false;
+
+            auto & object = out.emplace_object();
+            object.reserve(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                boost::json::value key(object.storage());
+                if (!Decode(data, offset, key, depth + 1) || !key.is_string())
+                    return false;
+
+                if (!Decode(data, offset, object[key.get_string()], depth + 1))
+                    return false;
+            }
+            return true;
+        }
+
+        bool Decode(const std::span<const uint8_t> data, std::size_t & offset, boost::json::value & out, const std::size_t depth)
+        {
+            if (offset >= data.size() || depth > MaxDepth)
+                return false;
+
+            const uint8_t tag = data[offset++];
+
+            if (tag <= 0x7F)
+            {
+                out = static_cast<int64_t>(tag);
+                return true;
+            }
+            if (tag >= 0xE0)
+            {
+                out = static_cast<int64_t>(static_cast<int8_t>(tag));
+                return true;
+            }
+            if ((tag & 0xE0) == 0xA0)
+                return ReadString(data, offset, tag & 0x1F, out);
+            if ((tag & 0xF0) == 0x90)
+                return ReadArray(data, offset, tag & 0x0F, out, depth);
+            if ((tag & 0xF0) == 0x80)
+                return ReadMap(data, offset, tag & 0x0F, out, depth);
+
+            switch (tag)
+            {
+                case 0xC0: out = nullptr; return true;
+                case 0xC2: out = false; return true;
+                case 0xC3: out = true; return true;
+
+                case 0xCC: { uint8_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<int64_t>(v); return true; }
+                case 0xCD: { uint16_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<int64_t>(v); return true; }
+                case 0xCE: { uint32_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<int64_t>(v); return true; }
+                case 0xCF:
+                {
+                    uint64_t v;
+                    if (!ReadBE(data, offset, v))
+                        return false;
+                    if (v <= static_cast<uint64_t>(INT64_MAX))
+                        out = static_cast<int64_t>(v);
+                    else
+                        out = v;
+                    return true;
+                }
+
+                case 0xD0: { uint8_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<int64_t>(static_cast<int8_t>(v)); return true; }
+                case 0xD1: { uint16_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<int64_t>(static_cast<int16_t>(v)); return true; }
+                case 0xD2: { uint32_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<int64_t>(static_cast<int32_t>(v)); return true; }
+                case 0xD3: { uint64_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<int64_t>(v); return true; }
+
+                case 0xCA: { uint32_t v; if (!ReadBE(data, offset, v)) return false; out = static_cast<double>(std::bit_cast<float>(v)); return true; }
+                case 0xCB: { uint64_t v; if (!ReadBE(data, offset, v)) return false; out = std::bit_cast<double>(v); return true; }
+
+                case 0xC4: case 0xD9: { uint8_t n; return ReadBE(data, offset, n) && ReadString(data, offset, n, out); }
+                case 0xC5: case 0xDA: { uint16_t n; return ReadBE(data, offset, n) && ReadString(data, offset, n, out); }
+                case 0xC6: case 0xDB: { uint32_t n; return ReadBE(data, offset, n) && ReadString(data, offset, n, out); }
+
+                case 0xDC: { uint16_t n; return ReadBE(data, offset, n) && ReadArray(data, offset, n, out, depth); }
+                case 0xDD: { uint32_t n; return ReadBE(data, offset, n) && ReadArray(data, offset, n, out, depth); }
+                case 0xDE: { uint16_t n; return ReadBE(data, offset, n) && ReadMap(data, offset, n, out, depth); }
+                case 0xDF: { uint32_t n; return ReadBE(data, offset, n) && ReadMap(data, offset, n, out, depth); }
+
+                default:
+                    return false; // ext types
+            }
+        }
+    }
+
+    void EncodeMsgPack(const boost::json::value & value, std::vector<uint8_t> & out)
+    {
+        switch (value.kind())
+        {
+            case boost::json::kind::null:
+                out.push_back(0xC0);
+                break;
+            case boost::json::kind::bool_:
+                out.push_back(value.get_bool() ? 0xC3 : 0xC2);
+                break;
+            case boost::json::kind::int64:
+                WriteInt(out, value.get_int64());
+                break;
+            case boost::json::kind::uint64:
+                if (value.get_uint64() <= static_cast<uint64_t>(INT64_MAX))
+                    WriteInt(out, static_cast<int64_t>(value.get_uint64()));
+                else
+                {
+                    out.push_back(0xCF);
+                    WriteBE<uint64_t>(out, value.get_uint64());
+                }
+                break;
+            case boost::json::kind::double_:
+                out.push_back(0xCB);
+                WriteBE<uint64_t>(out, std::bit_cast<uint64_t>(value.get_double()));
+                break;
+            case boost::json::kind::string:
+                WriteString(out, value.get_string());
+                break;
+            case boost::json::kind::array:
+                WriteContainer(out, value.get_array().size(), 0x90, 0xDC);
+                for (const auto & item : value.get_array())
+                    EncodeMsgPack(item, out);
+                break;
+            case boost::json::kind::object:
+                WriteContainer(out, value.get_object().size(), 0x80, 0xDE);
+                for (const auto & [key, item] : value.get_object())
+                {
+                    WriteString(out, key);
+                    EncodeMsgPack(item, out);
+                }
+                break;
+        }
+    }
+
+    bool DecodeMsgPack(const std::span<const uint8_t> data, std::size_t & offset, boost::json::value & out)
+    {
+        return Decode(data, offset, out, 0);
+    }
+
+} // namespace Core::Servers::Websocket
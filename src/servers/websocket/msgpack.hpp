@@ -0,0 +1,22 @@
+#pragma once
+
+#include <boost/json.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Core::Servers::Websocket {
+    /*
+        MessagePack subset covering what boost::json can hold:
+        nil, bool, int (fixint, int8..64, uint8..64), float64, str (fixstr, str8/16/32),
+        array (fixarray, array16/32), map with string keys (fixmap, map16/32).
+        Decoding also accepts float32 and bin8/16/32 (as string).
+    */
+    void EncodeMsgPack(const boost::json::value & value, std::vector<uint8_t> & out);
+
+    // false on malformed or truncated input; offset is advanced past the value.
+    // Strings and containers are allocated from out's storage
+    bool DecodeMsgPack(std::span<const uint8_t> data, std::size_t & offset, boost::json::value & out);
+
+} // namespace Core::Servers::Websocket
@@ -0,0 +1,32 @@
+#include "servers/websocket/parse_arena.hpp"
+
+namespace Core::Servers::Websocket {
+
+    ParseArenaPool::Lease ParseArenaPool::Acquire()
+    {
+        std::unique_ptr<ParseArena> arena;
+        {
+            std::lock_guard lock(mutex_);
+            if (!free_.empty())
+            {
+                arena = std::move(free_.back());
+                free_.pop_back();
+            }
+        }
+
+        if (!arena)
+            arena = std::make_unique<ParseArena>(arenaBytes_);
+
+        return Lease(boost::json::make_shared_resource<LeasedArena>(shared_from_this(), std::move(arena)));
+    }
+
+    void ParseArenaPool::Release(std::unique_ptr<ParseArena> arena)
+    {
+        arena->Reset();
+
+        std::lock_guard lock(mutex_);
+        if (free_.size() < keep_)
+            free_.push_back(std::move(arena));
+    }
+
+} // namespace Core::Servers::Websocket
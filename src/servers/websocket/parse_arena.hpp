@@ -0,0 +1,119 @@
+#pragma once
+
+#include <boost/json.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Core::Servers::Websocket {
+    // Storage for one parsed message: a monotonic resource over a fixed buffer, reset and reused when released.
+    // Typical requests fit the buffer, larger ones spill into the upstream allocator until the reset.
+    class ParseArena
+    {
+        std::unique_ptr<unsigned char[]> buffer_;
+        boost::json::monotonic_resource resource_;
+
+    public:
+        explicit ParseArena(const std::size_t bytes):
+        buffer_(std::make_unique_for_overwrite<unsigned char[]>(bytes)), resource_(buffer_.get(), bytes) {}
+
+        ParseArena(const ParseArena &) = delete;
+        ParseArena & operator=(const ParseArena &) = delete;
+
+        [[nodiscard]] boost::json::memory_resource * Resource()
+        {
+            return &resource_;
+        }
+
+        void Reset()
+        {
+            resource_.release();
+        }
+    };
+
+    // Arenas of one client. Leases may outlive the client (a handler keeping its message), so they share the pool.
+    class ParseArenaPool : public std::enable_shared_from_this<ParseArenaPool>
+    {
+        std::mutex mutex_; // arenas are returned from whichever thread drops the last value
+        std::vector<std::unique_ptr<ParseArena>> free_;
+        std::size_t arenaBytes_;
+        std::size_t keep_;
+
+        // The resource a leased arena is handed out as. It is reference counted by boost::json::storage_ptr:
+        // the message body and every value copied out of it keep it, the last one returns the arena.
+        class LeasedArena final : public boost::json::memory_resource
+        {
+            std::shared_ptr<ParseArenaPool> pool_;
+            std::unique_ptr<ParseArena> arena_;
+
+        public:
+            LeasedArena(std::shared_ptr<ParseArenaPool> pool, std::unique_ptr<ParseArena> arena):
+            pool_(std::move(pool)), arena_(std::move(arena)) {}
+
+            ~LeasedArena() override
+            {
+                pool_->Release(std::move(arena_));
+            }
+
+        private:
+            void * do_allocate(const std::size_t bytes, const std::size_t alignment) override
+            {
+                return arena_->Resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void *, std::size_t, std::size_t) override
+            {
+                // monotonic: everything goes at once when the arena is reset
+            }
+
+            [[nodiscard]] bool do_is_equal(const boost::json::memory_resource & other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+    public:
+        using Shared = std::shared_ptr<ParseArenaPool>;
+
+        // Owning handle of one leased arena. Copyable: the arena stays out of the pool while any copy,
+        // or any boost::json value allocated from Storage(), is alive.
+        class Lease
+        {
+            boost::json::storage_ptr storage_;
+
+        public:
+            Lease() = default;
+            explicit Lease(boost::json::storage_ptr storage): storage_(std::move(storage)) {}
+
+            explicit operator bool() const
+            {
+                return storage_.is_shared();
+            }
+
+            // ref-counted, values allocated from it may be kept past the message
+            [[nodiscard]] const boost::json::storage_ptr & Storage() const
+            {
+                return storage_;
+            }
+        };
+
+        ParseArenaPool(const std::size_t arenaBytes, const std::size_t keep): arenaBytes_(arenaBytes), keep_(keep)
+        {
+            free_.reserve(keep_);
+        }
+
+        Lease Acquire();
+
+        void Release(std::unique_ptr<ParseArena> arena);
+
+        static Shared Create(const std::size_t arenaBytes, const std::size_t keep)
+        {
+            return std::make_shared<ParseArenaPool>(arenaBytes, keep);
+        }
+    };
+
+    using ParseLease = ParseArenaPool::Lease;
+
+} // namespace Core::Servers::Websocket
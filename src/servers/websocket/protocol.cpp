@@ -0,0 +1,159 @@
+#include "servers/websocket/protocol.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Core::Servers::Websocket {
+
+    namespace
+    {
+        void WriteVarint(std::vector<uint8_t> & out, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        bool ReadVarint(const std::span<const uint8_t> data, std::size_t & offset, uint64_t & value)
+        {
+            value = 0;
+            for (uint32_t shift = 0; shift < 64; shift += 7)
+            {
+                if (offset >= data.size())
+                    return false;
+
+                const uint8_t byte = data[offset++];
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    uint64_t MessageTypes::Hash(const std::string_view type, const uint64_t seed)
+    {
+        // FNV-1a with a seeded basis, folded so the low bits used by the mask see the whole hash
+        uint64_t hash = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+        for (const char c : type)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash ^ (hash >> 29) ^ (hash >> 47);
+    }
+
+    void MessageTypes::Rebuild()
+    {
+        constexpr uint64_t SeedAttempts = 1024;
+
+        std::vector<uint32_t> slots;
+        for (auto size = std::bit_ceil(std::max<std::size_t>(names_.size() * 2, 16)); ; size *= 2)
+        {
+            for (uint64_t seed = 1; seed <= SeedAttempts; ++seed)
+            {
+                slots.assign(size, 0);
+
+                bool collision = false;
+                for (uint32_t id = 1; id < names_.size() && !collision; ++id)
+                {
+                    auto & slot = slots[Hash(names_[id], seed) & (size - 1)];
+                    collision = slot != 0;
+                    slot = id;
+                }
+
+                if (!collision)
+                {
+                    slots_ = std::move(slots);
+                    seed_ = seed;
+                    return;
+                }
+            }
+        }
+    }
+
+    uint32_t MessageTypes::Intern(const std::string & type)
+    {
+        if (const auto id = Find(type))
+            return id;
+
+        const auto id = static_cast<uint32_t>(names_.size());
+        names_.push_back(type);
+        Rebuild();
+        return id;
+    }
+
+    uint32_t MessageTypes::Find(const std::string_view type) const
+    {
+        const auto id = slots_[Hash(type, seed_) & (slots_.size() - 1)];
+        return id != 0 && names_[id] == type ? id : 0;
+    }
+
+    const std::string * MessageTypes::Name(const uint32_t id) const
+    {
+        if (id == 0 || id >= names_.size())
+            return nullptr;
+
+        return &names_[id];
+    }
+
+    boost::json::object MessageTypes::Table() const
+    {
+        boost::json::object table;
+        table.reserve(Size());
+        for (uint32_t id = 1; id < names_.size(); ++id)
+            table[names_[id]] = id;
+
+        return table;
+    }
+
+    void EncodeBinaryEnvelope(std::vector<uint8_t> & out, const uint32_t typeID, const std::string_view type, const uint64_t sourceJobID, const uint64_t targetJobID)
+    {
+        out.push_back(BinaryMagic);
+        out.push_back(BinaryVersion);
+
+        WriteVarint(out, typeID);
+        if (typeID == 0)
+        {
+            WriteVarint(out, type.size());
+            out.insert(out.end(), type.begin(), type.end());
+        }
+
+        WriteVarint(out, sourceJobID);
+        WriteVarint(out, targetJobID);
+    }
+
+    bool DecodeBinaryEnvelope(const std::span<const uint8_t> frame, BinaryEnvelope & envelope)
+    {
+        if (frame.size() < 2 || frame[0] != BinaryMagic || frame[1] != BinaryVersion)
+            return false;
+
+        std::size_t offset = 2;
+        uint64_t typeID = 0;
+        if (!ReadVarint(frame, offset, typeID) || typeID > UINT32_MAX)
+            return false;
+
+        envelope.typeID = static_cast<uint32_t>(typeID);
+        envelope.typeName = {};
+        if (typeID == 0)
+        {
+            uint64_t length = 0;
+            if (!ReadVarint(frame, offset, length) || length > frame.size() - offset)
+                return false;
+
+            envelope.typeName = std::string_view(reinterpret_cast<const char *>(frame.data() + offset), length);
+            offset += length;
+        }
+
+        if (!ReadVarint(frame, offset, envelope.sourceJobID) || !ReadVarint(frame, offset, envelope.targetJobID))
+            return false;
+
+        envelope.bodyOffset = offset;
+        return true;
+    }
+
+} // namespace Core::Servers::Websocket
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/json.hpp>
+
+namespace Core::Servers::Websocket {
+    // wire format a client receives, chosen with "websocket::hello"
+    enum class Protocol : uint8_t
+    {
+        Json,
+        Binary,
+    };
+
+    inline std::string_view ProtocolName(const Protocol protocol)
+    {
+        return protocol == Protocol::Binary ? "binary" : "json";
+    }
+
+    // Message type names interned to small ids at registration. Id 0 means "not registered" / "name follows inline".
+    // Lookups go through a perfect hash rebuilt on every Intern, so the request path neither allocates nor probes.
+    class MessageTypes
+    {
+        std::deque<std::string> names_ { std::string{} }; // stable references, Message points into it
+
+        // slots_[Hash(name, seed_) & (slots_.size() - 1)] == id, collision free for the registered names
+        std::vector<uint32_t> slots_ { 0 };
+        uint64_t seed_ = 0;
+
+        static uint64_t Hash(std::string_view type, uint64_t seed);
+
+        void Rebuild();
+
+    public:
+        uint32_t Intern(const std::string & type);
+
+        // 0 if the type was never registered
+        [[nodiscard]] uint32_t Find(std::string_view type) const;
+
+        // nullptr for 0 and unknown ids
+        [[nodiscard]] const std::string * Name(uint32_t id) const;
+
+        [[nodiscard]] std::size_t Size() const
+        {
+            return names_.size() - 1;
+        }
+
+        // {"<type>": id, ...}, sent to clients switching to the binary protocol
+        [[nodiscard]] boost::json::object Table() const;
+    };
+
+    /*
+        Binary frame:
+            u8      BinaryMagic
+            u8      BinaryVersion
+            varint  typeID, 0 -> varint length + type name
+            varint  sourceJobId
+            varint  targetJobId
+            ...     body, a MessagePack map (see msgpack.hpp)
+    */
+    constexpr uint8_t BinaryMagic = 0xB1;
+    constexpr uint8_t BinaryVersion = 1;
+
+    struct BinaryEnvelope
+    {
+        uint32_t typeID = 0;
+        std::string_view typeName; // into the frame, only when typeID == 0
+        uint64_t sourceJobID = 0;
+        uint64_t targetJobID = 0;
+        std::size_t bodyOffset = 0;
+    };
+
+    void EncodeBinaryEnvelope(std::vector<uint8_t> & out, uint32_t typeID, std::string_view type, uint64_t sourceJobID, uint64_t targetJobID);
+
+    bool DecodeBinaryEnvelope(std::span<const uint8_t> frame, BinaryEnvelope & envelope);
+
+    // parse / serialize cost per protocol, logged by the server every minute. Updated from any thread
+    struct ProtocolStats
+    {
+        struct Counters
+        {
+            std::atomic<uint64_t> messages = 0;
+            std::atomic<uint64_t> bytes = 0;
+            std::atomic<uint64_t> ns = 0;
+
+            void Add(const std::size_t size, const uint64_t elapsedNs)
+            {
+                messages.fetch_add(1, std::memory_order_relaxed);
+                bytes.fetch_add(size, std::memory_order_relaxed);
+                ns.fetch_add(elapsedNs, std::memory_order_relaxed);
+            }
+
+            void Reset()
+            {
+                messages = 0;
+                bytes = 0;
+                ns = 0;
+            }
+        };
+
+        Counters parsed[2];
+        Counters serialized[2];
+
+        Counters & Parsed(const Protocol protocol)
+        {
+            return parsed[static_cast<std::size_t>(protocol)];
+        }
+
+        Counters & Serialized(const Protocol protocol)
+        {
+            return serialized[static_cast<std::size_t>(protocol)];
+        }
+
+        void Reset()
+        {
+            for (auto & counters : parsed)
+                counters.Reset();
+            for (auto & counters : serialized)
+                counters.Reset();
+        }
+    };
+
+} // namespace Core::Servers::Websocket
@@ -1,24 +1,63 @@
 #include "servers/websocket/server.hpp"
+#include "servers/websocket/msgpack.hpp"
 
+#include "utils.hpp"
+
+#include <algorithm>
 #include <chrono>
-#include <ranges>
 
 namespace Core::Servers::Websocket {
 
     using namespace std::chrono_literals;
 
+    namespace
+    {
+        // {"protocol": "binary" | "json"}, answered in the protocol the client is leaving
+        const std::string HelloType = "websocket::hello";
+        const std::string HelloResponseType = "websocket::hello::response";
+
+        uint64_t ElapsedNs(const std::chrono::steady_clock::time_point start)
+        {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
     void WebsocketService::Initialise()
     {
         Net::ServerConfig config;
         config.address   = "0.0.0.0";
         config.port      = 9100;
-        config.mode      = Net::Mode::Json;
+        config.mode      = Net::Mode::Text; // parsed in OnMessage, so the body can be moved into the Message; binary frames arrive as bytes
         config.ioThreads = 4;
         config.useTls    = false;
 
         server_ = Net::Server::Create(config, shared_from_this(), Log());
 
-        Log()->Debug("Server created on {}:{}", config.address, config.port);
+        helloTypeID_ = types_.Intern(HelloType);
+        types_.Intern(HelloResponseType);
+
+        parseArenaBytes_ = static_cast<std::size_t>(std::max(0, Utils::EnvInt("WS_PARSE_ARENA_BYTES", 8192)));
+
+        // last resort for strand jobs outside Dispatch(), which reports handler errors to the client itself
+        workers_.SetErrorHandler([this](const std::exception_ptr & error)
+        {
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (const std::exception & e)
+            {
+                Log()->Error("Worker job failed: {}", e.what());
+            }
+            catch (...)
+            {
+                Log()->Error("Worker job failed: unknown exception");
+            }
+        });
+        workers_.Start(static_cast<std::size_t>(std::max(0, Utils::EnvInt("WS_WORKER_THREADS", 4))));
+
+        Log()->Debug("Server created on {}:{}, {} worker threads", config.address, config.port, workers_.Threads());
     }
 
     void WebsocketService::OnAllServicesLoaded()
@@ -37,10 +76,74 @@ namespace Core::Servers::Websocket {
     {
         server_->ProcessTick();
 
-        for (const auto &client: clients_ | std::views::values)
+        // only due wheel slots are visited, idle clients cost nothing here
+        std::vector<JobTimer> due;
+        jobTimers_.Advance(std::chrono::steady_clock::now(), due);
+
+        for (const auto & timer : due)
+        {
+            if (const auto client = timer.client.lock())
+            {
+                // on the strand, like the response it stands in for
+                Post(client, [this, client, jobID = timer.jobID]
+                {
+                    if (client->ExpireJob(jobID))
+                        stats_.jobTimeouts++;
+                });
+            }
+        }
+
+        LogRequestStats();
+    }
+
+    void WebsocketService::LogRequestStats()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration<double>(now - stats_.since).count();
+        if (elapsed < 60.0)
+            return;
+
+        const uint64_t requests = stats_.requests;
+        const auto timers = jobTimers_.Size();
+        if (requests || timers)
         {
-            client->ProcessTick();
+            const auto perRequest = [requests](const uint64_t ns)
+            {
+                return requests ? static_cast<double>(ns) / 1000.0 / static_cast<double>(requests) : 0.0;
+            };
+
+            Log()->Debug("[WS] requests={} ({:.1f}/s) handling={:.1f}us/request queued={:.1f}us/request (max {:.1f}us) jobTimers={} timeouts={} errors={}",
+                         requests,
+                         static_cast<double>(requests) / elapsed,
+                         perRequest(stats_.handleNs),
+                         perRequest(stats_.queueNs),
+                         static_cast<double>(stats_.queueMaxNs) / 1000.0,
+                         timers,
+                         stats_.jobTimeouts.load(),
+                         stats_.handlerErrors.load());
+        }
+
+        for (const auto protocol : { Protocol::Json, Protocol::Binary })
+        {
+            const auto & parsed = stats_.protocol.Parsed(protocol);
+            const auto & serialized = stats_.protocol.Serialized(protocol);
+            const uint64_t parsedCount = parsed.messages;
+            const uint64_t serializedCount = serialized.messages;
+            if (!parsedCount && !serializedCount)
+                continue;
+
+            const auto perMessage = [](const uint64_t count, const uint64_t value)
+            {
+                return count ? static_cast<double>(value) / static_cast<double>(count) : 0.0;
+            };
+
+            Log()->Debug("[WS] {}: parsed={} ({:.0f}B, {:.2f}us/msg) serialized={} ({:.0f}B, {:.2f}us/msg)",
+                         ProtocolName(protocol),
+                         parsedCount, perMessage(parsedCount, parsed.bytes), perMessage(parsedCount, parsed.ns) / 1000.0,
+                         serializedCount, perMessage(serializedCount, serialized.bytes), perMessage(serializedCount, serialized.ns) / 1000.0);
         }
+
+        stats_.Reset(now);
     }
 
     void WebsocketService::OnSessionConnected(const Net::Session::Shared & session)
@@ -50,8 +153,11 @@ namespace Core::Servers::Websocket {
                         session->RemotePort());
 
         const auto client = CreateClient(session);
-        for (const auto & handler : clientHandlers_)
-            handler(client, Client::Events::ClientConnected);
+        Post(client, [this, client]
+        {
+            for (const auto & handler : clientHandlers_)
+                handler(client, Client::Events::ClientConnected);
+        });
     }
 
     void WebsocketService::OnSessionDisconnected(const Net::Session::Shared & session)
@@ -60,23 +166,138 @@ namespace Core::Servers::Websocket {
                         session->RemoteAddress(),
                         session->RemotePort());
 
+        // behind every message of the client already queued on its strand
         const auto client = CloseClient(session);
-        client->Disconnected();
-        for (const auto & handler : clientHandlers_)
-            handler(client, Client::Events::ClientDisconnected);
+        Post(client, [this, client]
+        {
+            client->Close();
+            for (const auto & handler : clientHandlers_)
+                handler(client, Client::Events::ClientDisconnected);
+        });
+    }
+
+    void WebsocketService::Post(const Client::Shared & client, std::function<void()> job)
+    {
+        const auto queued = std::chrono::steady_clock::now();
+
+        client->GetStrand()->Post([this, queued, job = std::move(job)]
+        {
+            const auto waited = ElapsedNs(queued);
+            stats_.queueNs.fetch_add(waited, std::memory_order_relaxed);
+
+            auto max = stats_.queueMaxNs.load(std::memory_order_relaxed);
+            while (waited > max && !stats_.queueMaxNs.compare_exchange_weak(max, waited, std::memory_order_relaxed)) {}
+
+            job();
+        });
+    }
+
+    void WebsocketService::OnMessage(const Net::Session::Shared & session, const std::vector<uint8_t> & data)
+    {
+        const auto client = GetClient(session);
+        if (!client)
+            return;
+
+        Post(client, [this, client, data]
+        {
+            HandleBinary(client, data);
+        });
+    }
+
+    void WebsocketService::HandleBinary(const Client::Shared & client, const std::vector<uint8_t> & data)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        BinaryEnvelope envelope;
+        if (!DecodeBinaryEnvelope(data, envelope)) {
+            Log()->Warning("Incoming binary message has no valid envelope");
+            return;
+        }
+
+        // an inline name may still be a registered type
+        const auto typeID = envelope.typeID != 0 ? envelope.typeID : types_.Find(envelope.typeName);
+        const auto name = types_.Name(typeID);
+        if (envelope.typeID != 0 && name == nullptr) {
+            Log()->Warning("Incoming binary message has unknown type id {}", envelope.typeID);
+            return;
+        }
+
+        std::size_t offset = envelope.bodyOffset;
+        auto lease = client->AcquireArena();
+        boost::json::value body(lease.Storage());
+        if (!DecodeMsgPack(data, offset, body) || offset != data.size() || !body.is_object()) {
+            Log()->Warning("Incoming binary message '{}' has no MessagePack map body", name ? std::string_view(*name) : envelope.typeName);
+            return;
+        }
+
+        const Headers headers{ envelope.sourceJobID, envelope.targetJobID };
+        const auto message = name
+            ? Message::Create(this, headers, typeID, *name, std::move(body.as_object()), std::move(lease))
+            : Message::Create(this, headers, std::string(envelope.typeName), std::move(body.as_object()), std::move(lease));
+
+        stats_.protocol.Parsed(Protocol::Binary).Add(data.size(), ElapsedNs(start));
+
+        Dispatch(client, message);
+
+        stats_.requests++;
+        stats_.handleNs += ElapsedNs(start);
+    }
+
+    void WebsocketService::OnMessage(const Net::Session::Shared & session, const std::string_view text)
+    {
+        session->Log()->Debug("Message: {}", text);
+
+        const auto client = GetClient(session);
+        if (!client)
+            return;
+
+        // the frame buffer belongs to the library, the strand gets its own copy
+        Post(client, [this, client, text = std::string(text)]
+        {
+            HandleText(client, text);
+        });
     }
 
     void WebsocketService::OnMessage(const Net::Session::Shared & session,
                                          const boost::json::value & jsonValue)
     {
-        session->Log()->Debug("Message: {}", serialize(jsonValue));
+        const auto client = GetClient(session);
+        if (!client)
+            return;
+
+        // Mode::Json: the library owns the parsed value
+        Post(client, [this, client, jsonValue]
+        {
+            HandleMessage(client, jsonValue, {}, std::chrono::steady_clock::now(), 0);
+        });
+    }
 
-        if (!jsonValue.is_object()) {
+    void WebsocketService::HandleText(const Client::Shared & client, const std::string_view text)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        // the whole tree lands in a reused client arena; the Message keeps it leased
+        auto lease = client->AcquireArena();
+
+        boost::system::error_code ec;
+        auto value = client->ParseJson(text, lease.Storage(), ec);
+        if (ec) {
+            Log()->Warning("Incoming message is not valid JSON: {}", ec.message());
+            return;
+        }
+
+        HandleMessage(client, std::move(value), std::move(lease), start, text.size());
+    }
+
+    void WebsocketService::HandleMessage(const Client::Shared & client, boost::json::value value, ParseLease lease,
+                                         const std::chrono::steady_clock::time_point start, const std::size_t size)
+    {
+        if (!value.is_object()) {
             Log()->Warning("Incoming JSON is not an object");
             return;
         }
 
-        const boost::json::object & obj = jsonValue.as_object();
+        boost::json::object & obj = value.as_object();
 
         const boost::json::value * headersValue = obj.if_contains("headers");
         if (headersValue == nullptr || !headersValue->is_object()) {
@@ -84,7 +305,7 @@ namespace Core::Servers::Websocket {
             return;
         }
 
-        const auto headers = Headers::Create(this, headersValue->as_object());
+        const auto headers = ParseHeaders(headersValue->as_object());
 
         const boost::json::value * typeValue = obj.if_contains("type");
         if (typeValue == nullptr || !typeValue->is_string()) {
@@ -92,27 +313,98 @@ namespace Core::Servers::Websocket {
             return;
         }
 
-        const std::string type = std::string(typeValue->as_string());
+        const std::string_view type = typeValue->as_string();
 
-        const boost::json::value * messageValue = obj.if_contains("message");
+        boost::json::value * messageValue = obj.if_contains("message");
         if (messageValue == nullptr || !messageValue->is_object()) {
             Log()->Warning("Incoming JSON has no object 'message' field");
             return;
         }
 
-        const auto message = Message::Create(this, headers, type, messageValue->get_object());
-        const auto client = GetClient(session);
+        // registered types point at the interned name instead of copying it
+        const auto typeID = types_.Find(type);
+        auto & body = messageValue->as_object();
+        const auto message = typeID
+            ? Message::Create(this, headers, typeID, *types_.Name(typeID), std::move(body), std::move(lease))
+            : Message::Create(this, headers, std::string(type), std::move(body), std::move(lease));
+
+        stats_.protocol.Parsed(Protocol::Json).Add(size, ElapsedNs(start));
+
+        Dispatch(client, message);
+
+        stats_.requests++;
+        stats_.handleNs += ElapsedNs(start);
+    }
+
+    void WebsocketService::Dispatch(const Client::Shared & client, const Message::Shared & message)
+    {
         client->OnMessage(message);
 
-        if (const auto it = messageHandlers_.find(type); it != messageHandlers_.end()) {
-            for (const auto & handler : it->second)
-                handler(client, message);
+        const auto typeID = message->GetTypeID();
+        if (typeID == 0)
+            return;
+
+        if (typeID == helloTypeID_) {
+            HandleHello(client, message);
+            return;
+        }
+
+        if (typeID < messageHandlers_.size()) {
+            for (const auto & handler : messageHandlers_[typeID])
+            {
+                try
+                {
+                    handler(client, message);
+                }
+                catch (const std::exception & e)
+                {
+                    FailMessage(client, message, e.what());
+                }
+                catch (...)
+                {
+                    FailMessage(client, message, "unknown exception");
+                }
+            }
         }
     }
 
+    void WebsocketService::FailMessage(const Client::Shared & client, const Message::Shared & message, const std::string_view error)
+    {
+        stats_.handlerErrors++;
+
+        client->Log()->Error("Handler for '{}' failed: {}", message->GetType(), error);
+        client->Send(message->GetType() + "::response",
+                     {{"success", false}, {"message", "internal_server_error"}},
+                     message->GetHeaders().GetSourceJobID());
+    }
+
+    void WebsocketService::HandleHello(const Client::Shared & client, const Message::Shared & message)
+    {
+        const auto * value = message->GetBody().if_contains("protocol");
+        const bool binary = value != nullptr && value->is_string() && value->get_string() == "binary";
+        const auto protocol = binary ? Protocol::Binary : Protocol::Json;
+
+        boost::json::object response;
+        response["protocol"] = ProtocolName(protocol);
+        if (binary)
+            response["types"] = types_.Table();
+
+        // the id table has to arrive in a format the client can already read
+        client->Send(HelloResponseType, response, message->GetHeaders().GetSourceJobID());
+        client->SetProtocol(protocol);
+
+        client->Log()->Debug("Protocol: {}", ProtocolName(protocol));
+    }
+
     void WebsocketService::RegisterMessage(const std::string & type, const MessageCallback & callback)
     {
-        messageHandlers_[type].push_back(callback);
+        const auto typeID = types_.Intern(type);
+        types_.Intern(type + "::response");
+
+        if (messageHandlers_.size() <= typeID)
+            messageHandlers_.resize(typeID + 1);
+
+        messageHandlers_[typeID].push_back(callback);
     }
 
     void WebsocketService::RegisterClientsCallback(const ClientCallback & callback)
@@ -120,4 +412,64 @@ namespace Core::Servers::Websocket {
         clientHandlers_.push_back(callback);
     }
 
+    void WebsocketService::Subscribe(const std::string & topic, const Interface::Client::Shared & client)
+    {
+        const auto impl = std::dynamic_pointer_cast<Client>(client);
+        if (!impl)
+            return;
+
+        // CloseClient marks the client disconnected before taking this lock
+        std::lock_guard lock(subscriptionsMutex_);
+        if (!impl->IsConnected())
+            return;
+
+        subscriptions_[topic].insert(impl);
+    }
+
+    void WebsocketService::Unsubscribe(const std::string & topic, const Interface::Client::Shared & client)
+    {
+        std::lock_guard lock(subscriptionsMutex_);
+        const auto it = subscriptions_.find(topic);
+        if (it == subscriptions_.end())
+            return;
+
+        it->second.erase(std::dynamic_pointer_cast<Client>(client));
+        if (it->second.empty())
+            subscriptions_.erase(it);
+    }
+
+    void WebsocketService::Publish(const std::string & topic, const std::string & type, const std::string_view body)
+    {
+        std::vector<Client::Shared> subscribers;
+        {
+            std::lock_guard lock(subscriptionsMutex_);
+            const auto it = subscriptions_.find(topic);
+            if (it == subscriptions_.end())
+                return;
+
+            subscribers.assign(it->second.begin(), it->second.end());
+        }
+
+        const Interface::PreparedMessage message(type, body);
+        for (const auto & client : subscribers)
+            client->SendPrepared(message);
+    }
+
+    void WebsocketService::Broadcast(const Interface::PreparedMessage::Shared & message, const std::vector<Interface::Client::Shared> & recipients)
+    {
+        if (!message)
+            return;
+
+        for (const auto & client : recipients)
+        {
+            if (client && client->IsConnected())
+                client->SendPrepared(*message);
+        }
+    }
+
+    void WebsocketService::Broadcast(const std::string & type, const boost::json::object & body, const std::vector<Interface::Client::Shared> & recipients)
+    {
+        Broadcast(Interface::PreparedMessage::Create(type, body), recipients);
+    }
+
 } // namespace Core::Servers::Websocket
\ No newline at end of file
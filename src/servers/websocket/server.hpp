@@ -3,12 +3,16 @@
 #include "interfaces/server.hpp"
 #include "client.hpp"
 #include "message.hpp"
+#include "protocol.hpp"
 
 #include <websocket.hpp>
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Core::Servers::Websocket {
     namespace Net = Utils::Net::Websocket;
@@ -22,15 +26,72 @@ namespace Core::Servers::Websocket {
         public std::enable_shared_from_this<WebsocketService>
     {
         Net::Server::Shared server_;
-        std::unordered_map<std::string, std::vector<MessageCallback>> messageHandlers_;
+        std::vector<std::vector<MessageCallback>> messageHandlers_; // by type id, see MessageTypes
         std::vector<ClientCallback> clientHandlers_;
 
         std::unordered_map<Net::Session::Shared, Client::Shared> clients_;
+
+        std::mutex subscriptionsMutex_; // Subscribe from handler strands, Publish from the main loop
+        std::unordered_map<std::string, std::unordered_set<Client::Shared>> subscriptions_; // topic -> subscribers
+
+        MessageTypes types_;
+
+        JobTimers jobTimers_; // Request() timeouts of every client
+        uint32_t helloTypeID_ = 0;
+
+        // updated from worker strands, reset in place: clients keep a pointer to protocol
+        struct RequestStats
+        {
+            std::atomic<uint64_t> requests = 0;
+            std::atomic<uint64_t> handleNs = 0; // parse + dispatch
+            std::atomic<uint64_t> queueNs = 0;  // main loop -> client strand
+            std::atomic<uint64_t> queueMaxNs = 0;
+            std::atomic<uint64_t> jobTimeouts = 0;
+            std::atomic<uint64_t> handlerErrors = 0;
+            ProtocolStats protocol;
+            std::chrono::steady_clock::time_point since = std::chrono::steady_clock::now();
+
+            void Reset(const std::chrono::steady_clock::time_point now)
+            {
+                requests = 0;
+                handleNs = 0;
+                queueNs = 0;
+                queueMaxNs = 0;
+                jobTimeouts = 0;
+                handlerErrors = 0;
+                protocol.Reset();
+                since = now;
+            }
+        };
+        RequestStats stats_;
+
+        std::size_t parseArenaBytes_ = 0;
+
+        // handlers run here, one strand per client; without threads everything stays on the main loop
+        WorkerPool workers_;
+
+        // posts to the client strand, recording how long the job waited
+        void Post(const Client::Shared & client, std::function<void()> job);
+
+        void HandleBinary(const Client::Shared & client, const std::vector<uint8_t> & data);
+
+        void HandleText(const Client::Shared & client, std::string_view text);
+
+        void HandleMessage(const Client::Shared & client, boost::json::value value, ParseLease lease, std::chrono::steady_clock::time_point start, std::size_t size);
+
+        void Dispatch(const Client::Shared & client, const Message::Shared & message);
+
+        // a handler threw: logged with the client and type, answered with an internal_server_error response
+        void FailMessage(const Client::Shared & client, const Message::Shared & message, std::string_view error);
+
+        void HandleHello(const Client::Shared & client, const Message::Shared & message);
+
+        void LogRequestStats();
     public:
         using Shared    = std::shared_ptr<WebsocketService>;
 
         WebsocketService() = default;
-        ~WebsocketService() override = default;
+        ~WebsocketService() override = default; // workers_ is declared after what its jobs touch
 
     protected:
         void Initialise() override;
@@ -40,12 +101,24 @@ namespace Core::Servers::Websocket {
     public:
         void OnSessionConnected(const Net::Session::Shared & session) override;
         void OnSessionDisconnected(const Net::Session::Shared & session) override;
+        void OnMessage(const Net::Session::Shared & session, const std::vector<uint8_t> & data) override;
+        void OnMessage(const Net::Session::Shared & session, std::string_view text) override;
         void OnMessage(const Net::Session::Shared & session, const boost::json::value & jsonValue) override;
 
         void RegisterMessage(const std::string & type, const MessageCallback & callback) override;
 
         void RegisterClientsCallback(const ClientCallback & callback) override;
 
+        void Subscribe(const std::string & topic, const Interface::Client::Shared & client) override;
+
+        void Unsubscribe(const std::string & topic, const Interface::Client::Shared & client) override;
+
+        void Publish(const std::string & topic, const std::string & type, std::string_view body) override;
+
+        void Broadcast(const Interface::PreparedMessage::Shared & message, const std::vector<Interface::Client::Shared> & recipients) override;
+
+        void Broadcast(const std::string & type, const boost::json::object & body, const std::vector<Interface::Client::Shared> & recipients) override;
+
         [[nodiscard]] Net::Server::Shared & Server()
         {
             return server_;
@@ -72,7 +145,13 @@ namespace Core::Servers::Websocket {
             if (const auto it = clients_.find(session); it != clients_.end())
                 Log()->Fatal("CreateClient: Client {} already exists", session->RemoteAddress());
 
-            return clients_[session] = Client::Create(this, session);
+            return clients_[session] = Client::Create(this, session, ClientContext{
+                .types = &types_,
+                .stats = &stats_.protocol,
+                .timers = &jobTimers_,
+                .workers = &workers_,
+                .parseArenaBytes = parseArenaBytes_,
+            });
         }
 
         Client::Shared CloseClient(const Net::Session::Shared & session)
@@ -82,8 +161,18 @@ namespace Core::Servers::Websocket {
                 Log()->Fatal("CloseClient: Client {} not found", session->RemoteAddress());
 
             const auto client = it->second;
-            client->Close();
             clients_.erase(it);
+
+            // before the topics are dropped, so a Subscribe still queued on the strand is refused
+            client->Disconnected();
+
+            std::lock_guard lock(subscriptionsMutex_);
+            for (auto topic = subscriptions_.begin(); topic != subscriptions_.end(); )
+            {
+                topic->second.erase(client);
+                topic = topic->second.empty() ? subscriptions_.erase(topic) : std::next(topic);
+            }
+
             return client;
         }
     };
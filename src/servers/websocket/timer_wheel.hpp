@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Core::Servers::Websocket {
+    /*
+        Hierarchical timer wheel: Levels x 64 slots, level 0 slots are one resolution step wide,
+        each next level 64 times wider. Advance() only visits slots that became due, entries from
+        a wider slot are cascaded down when the lower levels wrap. Deadlines past the last level
+        are clamped, so an entry can fire early; the owner re-checks its own deadline.
+        Entries are never removed, a resolved timer is dropped by the expire callback.
+    */
+    template<typename T>
+    class TimerWheel
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        static constexpr uint32_t SlotBits = 6;
+        static constexpr uint32_t Slots = 1u << SlotBits;
+        static constexpr uint32_t Levels = 4;
+        static constexpr uint64_t Horizon = (1ull << (SlotBits * Levels)) - 1;
+
+        struct Entry
+        {
+            uint64_t tick = 0;
+            T value;
+        };
+
+        std::array<std::array<std::vector<Entry>, Slots>, Levels> wheel_ {};
+
+        Clock::duration resolution_;
+        Clock::time_point origin_ = Clock::now();
+        uint64_t current_ = 0; // last processed tick
+        std::size_t size_ = 0;
+
+        void Insert(Entry entry)
+        {
+            const auto delta = entry.tick - current_;
+
+            uint32_t level = 0;
+            while (level + 1 < Levels && delta >= (1ull << (SlotBits * (level + 1))))
+                level++;
+
+            wheel_[level][(entry.tick >> (SlotBits * level)) & (Slots - 1)].push_back(std::move(entry));
+        }
+
+        // moves the entries of a wider slot to where they belong now
+        void Cascade(const uint32_t level)
+        {
+            auto & slot = wheel_[level][(current_ >> (SlotBits * level)) & (Slots - 1)];
+            if (slot.empty())
+                return;
+
+            auto entries = std::move(slot);
+            slot.clear();
+
+            for (auto & entry : entries)
+                Insert(std::move(entry));
+        }
+
+    public:
+        explicit TimerWheel(const Clock::duration resolution = std::chrono::milliseconds{ 10 }): resolution_(resolution) {}
+
+        [[nodiscard]] std::size_t Size() const
+        {
+            return size_;
+        }
+
+        void Schedule(const Clock::time_point at, T value)
+        {
+            // rounded up, a timer never fires before its deadline unless clamped
+            const auto since = std::max(at - origin_, Clock::duration::zero());
+            uint64_t tick = static_cast<uint64_t>((since + resolution_ - Clock::duration{ 1 }) / resolution_);
+
+            tick = std::clamp(tick, current_ + 1, current_ + Horizon);
+
+            Insert(Entry{ .tick = tick, .value = std::move(value) });
+            size_++;
+        }
+
+        // expire(T &) for every entry due at now, returns how many fired
+        template<typename F>
+        std::size_t Advance(const Clock::time_point now, F && expire)
+        {
+            const auto target = static_cast<uint64_t>(std::max(now - origin_, Clock::duration::zero()) / resolution_);
+
+            if (size_ == 0)
+            {
+                // nothing pending, nothing to cascade
+                current_ = std::max(current_, target);
+                return 0;
+            }
+
+            std::size_t fired = 0;
+            while (current_ < target && size_ != 0)
+            {
+                ++current_;
+
+                // widest wrapped level first, its entries may land in a lower slot that is due now
+                uint32_t wrapped = 0;
+                while (wrapped + 1 < Levels && (current_ & ((1ull << (SlotBits * (wrapped + 1))) - 1)) == 0)
+                    wrapped++;
+
+                for (auto level = wrapped; level > 0; --level)
+                    Cascade(level);
+
+                auto & slot = wheel_[0][current_ & (Slots - 1)];
+                if (slot.empty())
+                    continue;
+
+                auto due = std::move(slot);
+                slot.clear();
+
+                size_ -= due.size();
+                fired += due.size();
+
+                for (auto & entry : due)
+                    expire(entry.value);
+            }
+
+            current_ = std::max(current_, target);
+            return fired;
+        }
+    };
+
+} // namespace Core::Servers::Websocket
@@ -0,0 +1,117 @@
+#include "servers/websocket/worker_pool.hpp"
+
+#include <utility>
+
+namespace Core::Servers::Websocket {
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto & thread : threads_)
+            thread.join();
+    }
+
+    void WorkerPool::Start(const std::size_t threads)
+    {
+        threads_.reserve(threads);
+        while (threads_.size() < threads)
+            threads_.emplace_back(&WorkerPool::Loop, this);
+    }
+
+    void WorkerPool::Run(const std::function<void()> & job) const
+    {
+        try
+        {
+            job();
+        }
+        catch (...)
+        {
+            if (onError_)
+                onError_(std::current_exception());
+        }
+    }
+
+    void WorkerPool::Post(std::function<void()> job)
+    {
+        if (!IsThreaded())
+        {
+            Run(job);
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        cv_.notify_one();
+    }
+
+    void WorkerPool::Loop()
+    {
+        std::unique_lock lock(mutex_);
+
+        while (true)
+        {
+            cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty())
+                return;
+
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+            lock.unlock();
+
+            Run(job);
+
+            job = nullptr;
+            lock.lock();
+        }
+    }
+
+    void Strand::Post(std::function<void()> job)
+    {
+        if (!pool_.IsThreaded())
+        {
+            pool_.Run(job);
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back(std::move(job));
+            if (std::exchange(running_, true))
+                return;
+        }
+
+        pool_.Post([self = shared_from_this()] { self->Drain(); });
+    }
+
+    void Strand::Drain()
+    {
+        for (std::size_t i = 0; i < Batch; ++i)
+        {
+            std::function<void()> job;
+            {
+                std::lock_guard lock(mutex_);
+                if (jobs_.empty())
+                {
+                    running_ = false;
+                    return;
+                }
+
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+
+            pool_.Run(job);
+        }
+
+        // more work left: requeue behind the other strands
+        pool_.Post([self = shared_from_this()] { self->Drain(); });
+    }
+
+} // namespace Core::Servers::Websocket
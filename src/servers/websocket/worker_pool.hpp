@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core::Servers::Websocket {
+    // Fixed set of threads running posted jobs in any order. Without threads every job runs inline in Post().
+    class WorkerPool
+    {
+    public:
+        using ErrorHandler = std::function<void(std::exception_ptr)>;
+
+    private:
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+
+        std::deque<std::function<void()>> jobs_;
+        bool stop_ = false;
+
+        ErrorHandler onError_; // set before Start()
+
+        void Loop();
+
+    public:
+        WorkerPool() = default;
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool & operator=(const WorkerPool &) = delete;
+
+        // runs the jobs already queued, then joins
+        ~WorkerPool();
+
+        // a job that throws is reported here instead of taking its worker down
+        void SetErrorHandler(ErrorHandler handler)
+        {
+            onError_ = std::move(handler);
+        }
+
+        void Start(std::size_t threads);
+
+        // runs the job, routing anything it throws to the error handler
+        void Run(const std::function<void()> & job) const;
+
+        [[nodiscard]] bool IsThreaded() const
+        {
+            return !threads_.empty();
+        }
+
+        [[nodiscard]] std::size_t Threads() const
+        {
+            return threads_.size();
+        }
+
+        void Post(std::function<void()> job);
+    };
+
+    // Jobs posted to one strand run one at a time and in order, on whichever pool thread is free.
+    // A strand is queued on the pool only while it has work, so idle strands cost nothing.
+    class Strand : public std::enable_shared_from_this<Strand>
+    {
+        static constexpr std::size_t Batch = 16; // jobs per turn before yielding the thread to other strands
+
+        WorkerPool & pool_;
+        std::mutex mutex_;
+        std::deque<std::function<void()>> jobs_;
+        bool running_ = false;
+
+        void Drain();
+
+    public:
+        using Shared = std::shared_ptr<Strand>;
+
+        explicit Strand(WorkerPool & pool): pool_(pool) {}
+
+        void Post(std::function<void()> job);
+
+        static Shared Create(WorkerPool & pool)
+        {
+            return std::make_shared<Strand>(pool);
+        }
+    };
+
+} // namespace Core::Servers::Websocket
@@ -1,11 +1,16 @@
 #include "controller.hpp"
 
+#include "utils.hpp"
+
 namespace Core::App::Game
 {
     void Controller::Initialise()
     {
         for (const auto serverID: {1, 2, 3})
             gameServers_.push_back(GameServer::Create(this, serverID));
+
+        pushed_.resize(gameServers_.size());
+        pushInterval_ = std::chrono::milliseconds{ Utils::EnvInt("GAME_PUSH_INTERVAL_MS", 250) };
     }
 
     void Controller::OnAllServicesLoaded()
@@ -22,6 +27,54 @@ namespace Core::App::Game
     {
         for (const auto& gameServer_: gameServers_)
             gameServer_->ProcessTick();
+
+        PushUpdates();
+    }
+
+    void Controller::PushUpdates()
+    {
+        // bounded rate: changes in between are coalesced into the next push
+        const auto now = std::chrono::steady_clock::now();
+        if (!websocket_ || now < nextPush_)
+            return;
+
+        nextPush_ = now + pushInterval_;
+
+        boost::json::array sessions;
+        bool sessionsChanged = false;
+
+        for (std::size_t i = 0; i < gameServers_.size(); ++i)
+        {
+            const auto summary = gameServers_[i]->GetSummary();
+            auto & pushed = pushed_[i];
+
+            if (summary->topJson != pushed.topJson)
+            {
+                pushed.topJson = summary->topJson;
+
+                websocket_->Publish(LeaderboardTopic(summary->serverID),
+                                    "player_session::leaderboard::update",
+                                    std::format(R"({{"serverId":{},"leaderboard":{}}})", summary->serverID, *summary->topJson));
+            }
+
+            if (summary->playersCount != pushed.playersCount)
+            {
+                pushed.playersCount = summary->playersCount;
+                sessionsChanged = true;
+            }
+
+            boost::json::object session;
+            session["id"] = summary->serverID;
+            session["players"] = summary->playersCount;
+            sessions.push_back(session);
+        }
+
+        // every arena, not just the changed ones: a subscriber that joined late or missed a push
+        // is whole again with the next one
+        if (sessionsChanged)
+            websocket_->Publish(StatsTopic,
+                                "player_session::stats::update",
+                                boost::json::serialize(boost::json::object{{"sessions", sessions}}));
     }
 
     std::vector<Interface::GameServer::Shared> Controller::GetGameServers() const
@@ -6,6 +6,8 @@
 
 #include "game_server.hpp"
 
+#include <chrono>
+
 namespace Core::App::Game
 {
     class Controller final : public Interface::Controller, public std::enable_shared_from_this<Controller>
@@ -16,6 +18,19 @@ namespace Core::App::Game
 
         Server::Shared websocket_;
         std::vector<GameServer::Shared> gameServers_;
+
+        // what subscribers have last been sent, per arena
+        struct Pushed
+        {
+            std::shared_ptr<const std::string> topJson;
+            uint32_t playersCount = 0;
+        };
+        std::vector<Pushed> pushed_;
+
+        std::chrono::milliseconds pushInterval_ { 250 };
+        std::chrono::steady_clock::time_point nextPush_ {};
+
+        void PushUpdates();
     public:
         using Shared = std::shared_ptr<Controller>;
 
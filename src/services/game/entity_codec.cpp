@@ -0,0 +1,372 @@
+#include "entity_codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Core::App::Game
+{
+    namespace
+    {
+        void WriteVarint(std::vector<std::uint8_t> & out, std::uint32_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        template<typename T>
+        void WriteRaw(std::vector<std::uint8_t> & out, const T & pod)
+        {
+            const auto * bytes = reinterpret_cast<const std::uint8_t *>(&pod);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        class ByteCursor
+        {
+            std::span<const std::uint8_t> data_;
+            std::size_t pos_ { 0 };
+
+        public:
+            explicit ByteCursor(const std::span<const std::uint8_t> data): data_(data) {}
+
+            [[nodiscard]] bool AtEnd() const
+            {
+                return pos_ == data_.size();
+            }
+
+            bool ReadByte(std::uint8_t & value)
+            {
+                if (pos_ >= data_.size())
+                    return false;
+
+                value = data_[pos_++];
+                return true;
+            }
+
+            bool ReadVarint(std::uint32_t & value)
+            {
+                value = 0;
+                for (std::uint32_t shift = 0; shift < 35; shift += 7)
+                {
+                    std::uint8_t byte = 0;
+                    if (!ReadByte(byte))
+                        return false;
+
+                    value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                        return true;
+                }
+
+                return false; // more than 5 bytes
+            }
+
+            template<typename T>
+            bool ReadRaw(T & pod)
+            {
+                if (data_.size() - pos_ < sizeof(T))
+                    return false;
+
+                std::memcpy(&pod, data_.data() + pos_, sizeof(T));
+                pos_ += sizeof(T);
+                return true;
+            }
+        };
+
+        std::uint8_t PackTypeFlags(const Net::EntityType type, const Net::EntityFlags flags)
+        {
+            return static_cast<std::uint8_t>(((static_cast<std::uint32_t>(type) & 0x0F) << 4) |
+                                             (static_cast<std::uint32_t>(flags) & 0x0F));
+        }
+    }
+
+    std::unique_ptr<EntityPayloadWriter> EntityPayloadWriter::Create(const bool compact, const std::size_t reserve)
+    {
+        if (compact)
+            return std::make_unique<CompactEntityWriter>(reserve);
+
+        return std::make_unique<LegacyEntityWriter>(reserve);
+    }
+
+    // ---------------------------------------------------------------- legacy
+
+    std::size_t LegacyEntityWriter::WriteRemove(const Net::EntityType type, const std::uint32_t entityID)
+    {
+        Net::EntityEntryHeader entry{};
+        entry.type = type;
+        entry.flags = Net::EntityFlags::Remove;
+        entry.entityID = entityID;
+        payload_.WritePod(entry);
+
+        entities_++;
+        return sizeof(entry);
+    }
+
+    std::size_t LegacyEntityWriter::WriteSnake(const Net::EntityFlags flags,
+                                               const std::uint32_t entityID,
+                                               const Net::SnakeState & state,
+                                               const std::vector<sf::Vector2f> & points)
+    {
+        Net::EntityEntryHeader entry{};
+        entry.type = Net::EntityType::Snake;
+        entry.flags = flags;
+        entry.entityID = entityID;
+
+        payload_.WritePod(entry);
+        payload_.WritePod(state);
+        for (const auto & v : points)
+            payload_.WriteVector2f(v);
+
+        entities_++;
+        return sizeof(entry) + sizeof(state) + points.size() * sizeof(float) * 2;
+    }
+
+    std::size_t LegacyEntityWriter::WriteFood(const Net::EntityFlags flags, const std::uint32_t entityID, const Net::FoodState & state)
+    {
+        Net::EntityEntryHeader entry{};
+        entry.type = Net::EntityType::Food;
+        entry.flags = flags;
+        entry.entityID = entityID;
+
+        payload_.WritePod(entry);
+        payload_.WritePod(state);
+
+        entities_++;
+        return sizeof(entry) + sizeof(state);
+    }
+
+    const std::vector<std::uint8_t> & LegacyEntityWriter::Finish()
+    {
+        return payload_.Data();
+    }
+
+    // ---------------------------------------------------------------- compact
+
+    std::size_t CompactEntityWriter::WriteRemove(const Net::EntityType type, const std::uint32_t entityID)
+    {
+        removes_.emplace_back(entityID, static_cast<std::uint8_t>(type));
+
+        entities_++;
+        legacyBytes_ += sizeof(Net::EntityEntryHeader);
+        return 1;
+    }
+
+    std::size_t CompactEntityWriter::WriteSnake(const Net::EntityFlags flags,
+                                                const std::uint32_t entityID,
+                                                const Net::SnakeState & state,
+                                                const std::vector<sf::Vector2f> & points)
+    {
+        Entry entry{};
+        entry.entityID = entityID;
+        entry.typeFlags = PackTypeFlags(Net::EntityType::Snake, flags);
+        entry.offset = static_cast<std::uint32_t>(body_.size());
+
+        WriteRaw(body_, state);
+        for (const auto & v : points)
+        {
+            WriteRaw(body_, v.x);
+            WriteRaw(body_, v.y);
+        }
+
+        entry.size = static_cast<std::uint32_t>(body_.size()) - entry.offset;
+        entries_.push_back(entry);
+
+        entities_++;
+        legacyBytes_ += sizeof(Net::EntityEntryHeader) + sizeof(state) + points.size() * sizeof(float) * 2;
+        return entry.size + 2;
+    }
+
+    std::size_t CompactEntityWriter::WriteFood(const Net::EntityFlags flags, const std::uint32_t entityID, const Net::FoodState & state)
+    {
+        const auto center = Utils::Legacy::Game::AreaCenter;
+
+        Entry entry{};
+        entry.entityID = entityID;
+        entry.typeFlags = PackTypeFlags(Net::EntityType::Food, flags);
+        entry.offset = static_cast<std::uint32_t>(body_.size());
+
+        WriteRaw(body_, QuantizeArenaAxis(state.x, center.x));
+        WriteRaw(body_, QuantizeArenaAxis(state.y, center.y));
+        WriteRaw(body_, state.color);
+        WriteVarint(body_, static_cast<std::uint32_t>(state.power));
+
+        entry.size = static_cast<std::uint32_t>(body_.size()) - entry.offset;
+        entries_.push_back(entry);
+
+        entities_++;
+        legacyBytes_ += sizeof(Net::EntityEntryHeader) + sizeof(state);
+        return entry.size + 2;
+    }
+
+    const std::vector<std::uint8_t> & CompactEntityWriter::Finish()
+    {
+        const auto & prefix = payload_.Data();
+
+        out_.clear();
+        out_.reserve(prefix.size() + body_.size() + entries_.size() * 3 + removes_.size() * 2 + 8);
+        out_.assign(prefix.begin(), prefix.end());
+        out_.push_back(CompactEntitiesMagic);
+
+        // removes: sorted, deduplicated, grouped into runs of consecutive IDs of the same type
+        std::ranges::sort(removes_);
+        const auto [first, last] = std::ranges::unique(removes_, {}, &std::pair<std::uint32_t, std::uint8_t>::first);
+        removes_.erase(first, last);
+
+        struct Run
+        {
+            std::uint32_t start;
+            std::uint32_t length;
+            std::uint8_t type;
+        };
+
+        std::vector<Run> runs;
+        for (const auto & [entityID, type] : removes_)
+        {
+            if (!runs.empty() && runs.back().type == type && runs.back().start + runs.back().length == entityID)
+            {
+                runs.back().length++;
+                continue;
+            }
+
+            runs.push_back({ entityID, 1, type });
+        }
+
+        WriteVarint(out_, static_cast<std::uint32_t>(runs.size()));
+
+        std::uint32_t previous = 0;
+        for (const auto & run : runs)
+        {
+            out_.push_back(run.type);
+            WriteVarint(out_, run.start - previous);
+            WriteVarint(out_, run.length - 1);
+            previous = run.start;
+        }
+
+        // entries: delta-coded IDs
+        std::ranges::sort(entries_, {}, &Entry::entityID);
+
+        WriteVarint(out_, static_cast<std::uint32_t>(entries_.size()));
+
+        previous = 0;
+        for (const auto & entry : entries_)
+        {
+            WriteVarint(out_, entry.entityID - previous);
+            previous = entry.entityID;
+
+            out_.push_back(entry.typeFlags);
+            out_.insert(out_.end(), body_.begin() + entry.offset, body_.begin() + entry.offset + entry.size);
+        }
+
+        return out_;
+    }
+
+    bool DecodeCompactEntities(const std::span<const std::uint8_t> data, CompactEntities & out)
+    {
+        const auto center = Utils::Legacy::Game::AreaCenter;
+
+        out.removes.clear();
+        out.entities.clear();
+
+        ByteCursor cursor(data);
+
+        std::uint8_t magic = 0;
+        if (!cursor.ReadByte(magic) || magic != CompactEntitiesMagic)
+            return false;
+
+        std::uint32_t runs = 0;
+        if (!cursor.ReadVarint(runs))
+            return false;
+
+        std::uint32_t previous = 0;
+        for (std::uint32_t i = 0; i < runs; ++i)
+        {
+            std::uint8_t type = 0;
+            std::uint32_t delta = 0;
+            std::uint32_t extra = 0;
+            if (!cursor.ReadByte(type) || !cursor.ReadVarint(delta) || !cursor.ReadVarint(extra))
+                return false;
+
+            const std::uint32_t start = previous + delta;
+            if (extra > UINT32_MAX - start)
+                return false;
+
+            // a five-byte varint would otherwise expand to billions of removes
+            if (extra >= CompactEntitiesMaxRemoves - out.removes.size())
+                return false;
+
+            for (std::uint32_t k = 0; k <= extra; ++k)
+                out.removes.emplace_back(start + k, static_cast<Net::EntityType>(type));
+
+            previous = start;
+        }
+
+        std::uint32_t count = 0;
+        if (!cursor.ReadVarint(count))
+            return false;
+
+        previous = 0;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            CompactEntity entity{};
+
+            std::uint32_t delta = 0;
+            std::uint8_t typeFlags = 0;
+            if (!cursor.ReadVarint(delta) || !cursor.ReadByte(typeFlags))
+                return false;
+
+            entity.entityID = previous + delta;
+            entity.type = static_cast<Net::EntityType>(typeFlags >> 4);
+            entity.flags = static_cast<Net::EntityFlags>(typeFlags & 0x0F);
+            previous = entity.entityID;
+
+            if (entity.type == Net::EntityType::Snake)
+            {
+                if (!cursor.ReadRaw(entity.snake))
+                    return false;
+
+                entity.points.resize(entity.snake.pointsCount);
+                for (auto & v : entity.points)
+                {
+                    if (!cursor.ReadRaw(v.x) || !cursor.ReadRaw(v.y))
+                        return false;
+                }
+            }
+            else if (entity.type == Net::EntityType::Food)
+            {
+                std::uint16_t x = 0;
+                std::uint16_t y = 0;
+                std::uint32_t power = 0;
+                if (!cursor.ReadRaw(x) || !cursor.ReadRaw(y) || !cursor.ReadRaw(entity.food.color) || !cursor.ReadVarint(power))
+                    return false;
+
+                entity.food.x = DequantizeArenaAxis(x, center.x);
+                entity.food.y = DequantizeArenaAxis(y, center.y);
+                entity.food.power = static_cast<decltype(entity.food.power)>(power);
+            }
+            else
+            {
+                return false;
+            }
+
+            out.entities.push_back(std::move(entity));
+        }
+
+        return cursor.AtEnd();
+    }
+
+    std::uint16_t QuantizeArenaAxis(const float value, const float center)
+    {
+        const float radius = Utils::Legacy::Game::AreaRadius;
+        const float t = std::clamp((value - (center - radius)) / (2.0f * radius), 0.0f, 1.0f);
+        return static_cast<std::uint16_t>(std::lround(t * 65535.0f));
+    }
+
+    float DequantizeArenaAxis(const std::uint16_t value, const float center)
+    {
+        const float radius = Utils::Legacy::Game::AreaRadius;
+        return center - radius + static_cast<float>(value) / 65535.0f * 2.0f * radius;
+    }
+}
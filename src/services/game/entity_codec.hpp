@@ -0,0 +1,152 @@
+#pragma once
+
+#include "game_messages.hpp"
+#include "legacy_logic.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Core::App::Game
+{
+    namespace Net = Utils::Legacy::Game::Net;
+
+    // first entity byte of a compact PartialUpdate / FullUpdate payload (after the message prefix)
+    constexpr std::uint8_t CompactEntitiesMagic = 0xCE;
+
+    // removes one decoded payload may expand to; a real tick carries a few hundred at most
+    constexpr std::uint32_t CompactEntitiesMaxRemoves = 1u << 16;
+
+    // collects the entity entries of one PartialUpdate / FullUpdate payload
+    class EntityPayloadWriter
+    {
+    protected:
+        Net::ByteWriter payload_;
+        std::size_t entities_ { 0 };
+
+    public:
+        explicit EntityPayloadWriter(const std::size_t reserve): payload_(reserve) {}
+        virtual ~EntityPayloadWriter() = default;
+
+        // message-specific prefix (FullUpdate header), written before any entity
+        Net::ByteWriter & Prefix()
+        {
+            return payload_;
+        }
+
+        [[nodiscard]] bool HasEntities() const
+        {
+            return entities_ != 0;
+        }
+
+        // each Write* returns the bytes the entry costs on the wire
+        virtual std::size_t WriteRemove(Net::EntityType type, std::uint32_t entityID) = 0;
+
+        virtual std::size_t WriteSnake(Net::EntityFlags flags,
+                                       std::uint32_t entityID,
+                                       const Net::SnakeState & state,
+                                       const std::vector<sf::Vector2f> & points) = 0;
+
+        virtual std::size_t WriteFood(Net::EntityFlags flags, std::uint32_t entityID, const Net::FoodState & state) = 0;
+
+        virtual const std::vector<std::uint8_t> & Finish() = 0;
+
+        static std::unique_ptr<EntityPayloadWriter> Create(bool compact, std::size_t reserve);
+    };
+
+    // EntityEntryHeader + raw state PODs, in visiting order
+    class LegacyEntityWriter final : public EntityPayloadWriter
+    {
+    public:
+        using EntityPayloadWriter::EntityPayloadWriter;
+
+        std::size_t WriteRemove(Net::EntityType type, std::uint32_t entityID) override;
+
+        std::size_t WriteSnake(Net::EntityFlags flags,
+                               std::uint32_t entityID,
+                               const Net::SnakeState & state,
+                               const std::vector<sf::Vector2f> & points) override;
+
+        std::size_t WriteFood(Net::EntityFlags flags, std::uint32_t entityID, const Net::FoodState & state) override;
+
+        const std::vector<std::uint8_t> & Finish() override;
+    };
+
+    /*
+        u8      CompactEntitiesMagic
+        varint  removeRuns
+                  u8 type, varint startID delta (from previous run start), varint runLength - 1
+        varint  entries, sorted by entity ID
+                  varint entityID delta (from previous entry), u8 (type << 4 | flags)
+                  Snake: SnakeState, pointsCount x (f32 x, f32 y)
+                  Food:  u16 x, u16 y quantized to the arena grid, Color, varint power
+    */
+    class CompactEntityWriter final : public EntityPayloadWriter
+    {
+        struct Entry
+        {
+            std::uint32_t entityID { 0 };
+            std::uint8_t typeFlags { 0 };
+            std::uint32_t offset { 0 };
+            std::uint32_t size { 0 };
+        };
+
+        std::vector<std::pair<std::uint32_t, std::uint8_t>> removes_; // entityID, type
+        std::vector<Entry> entries_;
+        std::vector<std::uint8_t> body_;
+        std::vector<std::uint8_t> out_;
+
+        std::size_t legacyBytes_ { 0 };
+
+    public:
+        using EntityPayloadWriter::EntityPayloadWriter;
+
+        std::size_t WriteRemove(Net::EntityType type, std::uint32_t entityID) override;
+
+        std::size_t WriteSnake(Net::EntityFlags flags,
+                               std::uint32_t entityID,
+                               const Net::SnakeState & state,
+                               const std::vector<sf::Vector2f> & points) override;
+
+        std::size_t WriteFood(Net::EntityFlags flags, std::uint32_t entityID, const Net::FoodState & state) override;
+
+        const std::vector<std::uint8_t> & Finish() override;
+
+        // what LegacyEntityWriter would have produced for the same payload
+        [[nodiscard]] std::size_t LegacyBytes() const
+        {
+            return payload_.Data().size() + legacyBytes_;
+        }
+    };
+
+    // one entry of a decoded compact payload; `snake` + `points` or `food` depending on `type`
+    struct CompactEntity
+    {
+        Net::EntityType type { Net::EntityType::Food };
+        Net::EntityFlags flags { Net::EntityFlags::New };
+        std::uint32_t entityID { 0 };
+
+        Net::SnakeState snake {};
+        std::vector<sf::Vector2f> points;
+
+        Net::FoodState food {};
+    };
+
+    struct CompactEntities
+    {
+        std::vector<std::pair<std::uint32_t, Net::EntityType>> removes; // entityID, type; ascending
+        std::vector<CompactEntity> entities;                            // ascending entity ID
+    };
+
+    // reverse of CompactEntityWriter::Finish; `data` starts at CompactEntitiesMagic (the message prefix is stripped).
+    // Returns false on a malformed or truncated payload.
+    bool DecodeCompactEntities(std::span<const std::uint8_t> data, CompactEntities & out);
+
+    // arena grid quantization used by the compact food encoding
+    std::uint16_t QuantizeArenaAxis(float value, float center);
+
+    float DequantizeArenaAxis(std::uint16_t value, float center);
+}
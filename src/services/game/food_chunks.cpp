@@ -0,0 +1,121 @@
+#include "food_chunks.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Core::App::Game
+{
+    void FoodChunks::Initialise(const sf::Vector2f center, const float radius, const float chunkSize)
+    {
+        chunkSize_ = chunkSize;
+        origin_ = { center.x - radius, center.y - radius };
+        side_ = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::ceil(2.0f * radius / chunkSize_)));
+
+        chunks_.assign(static_cast<std::size_t>(side_) * side_, Chunk{});
+        count_ = 0;
+        signature_ = 0;
+    }
+
+    std::vector<FoodView> & FoodChunks::Mutable(Chunk & chunk)
+    {
+        // only this instance holds it -> no published snapshot can observe the change
+        if (!chunk.foods)
+            chunk.foods = std::make_shared<std::vector<FoodView>>();
+        else if (chunk.foods.use_count() > 1)
+            chunk.foods = std::make_shared<std::vector<FoodView>>(*chunk.foods);
+
+        return *chunk.foods;
+    }
+
+    void FoodChunks::Add(const EntityFood::Shared & food)
+    {
+        auto & chunk = chunks_[IndexOf(food->GetPosition())];
+        auto & foods = Mutable(chunk);
+
+        const auto it = std::ranges::upper_bound(foods, food->EntityID(), {}, &FoodView::entityID);
+        foods.insert(it, FoodView{ food->EntityID(), MakeFoodState(food) });
+        chunk.version = ++versionCounter_;
+        count_++;
+    }
+
+    void FoodChunks::Remove(const EntityFood::Shared & food)
+    {
+        auto & chunk = chunks_[IndexOf(food->GetPosition())];
+
+        const auto current = chunk.Foods();
+        const auto found = std::ranges::lower_bound(current, food->EntityID(), {}, &FoodView::entityID);
+        if (found == current.end() || found->entityID != food->EntityID())
+            return;
+
+        const auto offset = found - current.begin();
+        auto & foods = Mutable(chunk);
+        foods.erase(foods.begin() + offset);
+        chunk.version = ++versionCounter_;
+        count_--;
+    }
+
+    std::uint32_t FoodChunks::IndexOf(const sf::Vector2f position) const
+    {
+        const auto cell = [&](const float v, const float origin)
+        {
+            const auto i = static_cast<std::int64_t>(std::floor((v - origin) / chunkSize_));
+            return static_cast<std::uint32_t>(std::clamp<std::int64_t>(i, 0, side_ - 1));
+        };
+
+        return cell(position.y, origin_.y) * side_ + cell(position.x, origin_.x);
+    }
+
+    sf::Vector2f FoodChunks::CenterOf(const std::uint32_t index) const
+    {
+        const auto cx = index % side_;
+        const auto cy = index / side_;
+        return { origin_.x + (static_cast<float>(cx) + 0.5f) * chunkSize_,
+                 origin_.y + (static_cast<float>(cy) + 0.5f) * chunkSize_ };
+    }
+
+    void FoodChunks::InRadius(const sf::Vector2f position, const float radius, std::vector<std::uint32_t> & out) const
+    {
+        out.clear();
+
+        const auto cell = [&](const float v, const float origin)
+        {
+            const auto i = static_cast<std::int64_t>(std::floor((v - origin) / chunkSize_));
+            return std::clamp<std::int64_t>(i, 0, side_ - 1);
+        };
+
+        const auto minX = cell(position.x - radius, origin_.x);
+        const auto maxX = cell(position.x + radius, origin_.x);
+        const auto minY = cell(position.y - radius, origin_.y);
+        const auto maxY = cell(position.y + radius, origin_.y);
+
+        const float r2 = radius * radius;
+
+        for (auto cy = minY; cy <= maxY; ++cy)
+        {
+            for (auto cx = minX; cx <= maxX; ++cx)
+            {
+                // closest point of the chunk rectangle to the circle center
+                const float left = origin_.x + static_cast<float>(cx) * chunkSize_;
+                const float top = origin_.y + static_cast<float>(cy) * chunkSize_;
+                const float dx = position.x - std::clamp(position.x, left, left + chunkSize_);
+                const float dy = position.y - std::clamp(position.y, top, top + chunkSize_);
+
+                if (dx * dx + dy * dy <= r2)
+                    out.push_back(static_cast<std::uint32_t>(cy * side_ + cx));
+            }
+        }
+    }
+
+    Utils::Legacy::Game::Net::FoodState MakeFoodState(const Utils::Legacy::Game::Entity::Food::Shared & food)
+    {
+        using namespace Utils::Legacy::Game::Net;
+
+        FoodState fs{};
+        fs.x = food->GetPosition().x;
+        fs.y = food->GetPosition().y;
+        fs.power = food->GetPower();
+        fs.color = *reinterpret_cast<const Color*>(&food->GetColor());
+        fs.killed = 0;
+        return fs;
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "game_messages.hpp"
+#include "legacy_entities.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Core::App::Game
+{
+    // what the network stage needs from a food entity, captured when it spawns
+    struct FoodView
+    {
+        std::uint32_t entityID { 0 };
+        Utils::Legacy::Game::Net::FoodState state {};
+    };
+
+    // Static food bucketed into a fixed grid over the arena.
+    // Every spawn / eat bumps the chunk version, so viewers only look at chunks that changed.
+    // Chunk contents are copy-on-write: copying FoodChunks (a world snapshot) shares them,
+    // and the next change to a shared chunk clones just that chunk.
+    class FoodChunks
+    {
+    public:
+        using EntityFood = Utils::Legacy::Game::Entity::Food;
+
+        struct Chunk
+        {
+            std::uint32_t version { 0 };
+            std::shared_ptr<std::vector<FoodView>> foods; // sorted by EntityID, may be null
+
+            [[nodiscard]] std::span<const FoodView> Foods() const
+            {
+                return foods ? std::span<const FoodView>(*foods) : std::span<const FoodView>{};
+            }
+        };
+
+    private:
+        sf::Vector2f origin_ {};
+        float chunkSize_ { 256.0f };
+        std::uint32_t side_ { 0 };
+
+        std::vector<Chunk> chunks_;
+        std::size_t count_ { 0 };
+        std::uint32_t versionCounter_ { 0 }; // global, so a version is never reused by any chunk
+
+        std::vector<FoodView> & Mutable(Chunk & chunk);
+
+    public:
+        FoodChunks() = default;
+
+        void Initialise(sf::Vector2f center, float radius, float chunkSize);
+
+        void Add(const EntityFood::Shared & food);
+
+        void Remove(const EntityFood::Shared & food);
+
+        template<typename Range>
+        void Rebuild(const Range & foods)
+        {
+            for (auto & chunk : chunks_)
+            {
+                if (!chunk.Foods().empty())
+                    chunk.version = ++versionCounter_;
+                chunk.foods.reset();
+            }
+            count_ = 0;
+
+            for (const auto & food : foods)
+                Add(food);
+        }
+
+        [[nodiscard]] std::size_t Count() const
+        {
+            return count_;
+        }
+
+        [[nodiscard]] const Chunk & Get(const std::uint32_t index) const
+        {
+            return chunks_[index];
+        }
+
+        [[nodiscard]] std::uint32_t IndexOf(sf::Vector2f position) const;
+
+        [[nodiscard]] sf::Vector2f CenterOf(std::uint32_t index) const;
+
+        // chunks whose rectangle intersects the circle
+        void InRadius(sf::Vector2f position, float radius, std::vector<std::uint32_t> & out) const;
+    };
+
+    Utils::Legacy::Game::Net::FoodState MakeFoodState(const Utils::Legacy::Game::Entity::Food::Shared & food);
+}
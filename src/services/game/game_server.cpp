@@ -1,11 +1,15 @@
 #include "game_server.hpp"
 
+#include <algorithm>
 #include <boost/crc.hpp>
+#include <boost/json.hpp>
+#include <chrono>
 #include <cmath>
 #include <ranges>
 #include <vector>
 
 #include "logging.hpp"
+#include "utils.hpp"
 
 namespace Core::App::Game
 {
@@ -24,28 +28,241 @@ namespace Core::App::Game
         cfg.ioThreads = 2;
 
         udpServer_ = UdpServer::Create(cfg, shared_from_this());
+
+        if (const auto error = compressor_.Initialise(CompressionConfig::FromEnv()); !error.empty())
+            Log()->Warning("[Net] Payload compression disabled: {}", error);
+
+        foodChunks_.Initialise(Utils::Legacy::Game::AreaCenter,
+                               Utils::Legacy::Game::AreaRadius,
+                               static_cast<float>(Utils::EnvInt("GAME_FOOD_CHUNK_SIZE", 256)));
+
+        lod_ = NetLodConfig::FromEnv();
+        lodTierBytes_.assign(lod_.tiers.size(), 0);
+
+        networkStage_.Start(Utils::EnvInt("GAME_NET_PIPELINE", 1) != 0);
+
+        leaderboard_.SetTopSize(static_cast<std::size_t>(std::max(1, Utils::EnvInt("GAME_LEADERBOARD_SIZE", 10))));
+        PublishSummary();
     }
 
     void GameServer::ProcessTick()
     {
+        using Clock = std::chrono::steady_clock;
+        const auto Nanos = [](const Clock::duration d)
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+        };
+
+        const auto simulateStart = Clock::now();
+
+        DrainInbox();
+
         Logic::ProcessTick();
 
         // send updates at 32 tickrate (logic is 64)
         if (const bool shouldSendUpdate = (frame_ % 2 == 0); !shouldSendUpdate)
+        {
+            pipelineStats_.simulateNs += Nanos(Clock::now() - simulateStart);
             return;
+        }
 
         for (auto& snake : snakes_)
         {
             ProcessSnake(snake);
         }
 
+        ReportExperience();
         ProcessKills();
         GenerateFoods();
+        SyncFoodChunks();
+
+        const auto publishStart = Clock::now();
+        pipelineStats_.simulateNs += Nanos(publishStart - simulateStart);
+
+        PublishSummary();
+
+        // tick N goes into the back buffer while the network stage may still be sending tick N - 1
+        auto& snapshot = snapshots_[backSnapshot_];
+        BuildSnapshot(snapshot);
+
+        const auto waitStart = Clock::now();
+        networkStage_.Wait();
+        const auto waitEnd = Clock::now();
+
+        // the network stage is idle: sessions, inputs and net state may change now
+        udpServer_->ProcessTick();
+        AssignViewers(snapshot);
+
+        pipelineStats_.ticks++;
+        pipelineStats_.waitNs += Nanos(waitEnd - waitStart);
+        pipelineStats_.publishNs += Nanos(waitStart - publishStart) + Nanos(Clock::now() - waitEnd);
+
+        // once a minute at 64 tickrate
+        if (frame_ % (64 * 60) == 0)
+            LogNetStats();
+
+        backSnapshot_ ^= 1;
+        networkStage_.Run([this, &snapshot] { SendUpdates(snapshot); });
+    }
+
+    void GameServer::BuildSnapshot(WorldSnapshot& snapshot) const
+    {
+        snapshot.Clear();
+        snapshot.frame = frame_;
+
+        for (const auto& snake : snakes_)
+            snapshot.AddSnake(snake);
+
+        // shares the chunk contents, the simulation clones a chunk on its next change
+        snapshot.foods = foodChunks_;
+    }
+
+    void GameServer::AssignViewers(WorldSnapshot& snapshot)
+    {
+        // left between BuildSnapshot and now: hide them as if they were killed this tick
+        for (const auto entityID : departedSnakes_)
+        {
+            if (const auto index = snapshot.IndexOf(entityID))
+                snapshot.snakes[*index].killed = true;
+        }
+        departedSnakes_.clear();
+
+        snapshot.viewers.clear();
+        for (const auto& [session, snake] : sessions_)
+        {
+            // connected after BuildSnapshot: served next tick, its fullUpdates_ entry stays
+            const auto index = snapshot.IndexOf(snake->EntityID());
+            if (!index)
+                continue;
+
+            const bool fullUpdate = fullUpdates_.erase(session) != 0;
+            snapshot.viewers.push_back({ session, *index, fullUpdate });
+        }
+    }
+
+    void GameServer::TrackScore(const UdpSession::Shared & session, const EntitySnake::Shared & snake)
+    {
+        const auto playerIt = players_.find(session->SessionId());
+        if (playerIt == players_.end() || snake->IsKilled())
+        {
+            leaderboard_.Remove(snake->EntityID());
+            return;
+        }
+
+        leaderboard_.Set(snake->EntityID(), playerIt->second.login, snake->GetExperience());
+    }
+
+    void GameServer::ReportExperience()
+    {
+        const bool periodic = frame_ % 64 == 0;
+        if (!periodic && killedSnakes_.empty())
+            return;
+
+        for (auto & [ssid, arenaPlayer] : players_)
+        {
+            const auto sessionIt = sessionsByID_.find(ssid);
+            if (sessionIt == sessionsByID_.end())
+                continue;
+
+            const auto & snake = sessions_.at(sessionIt->second);
+            if (const bool died = killedSnakes_.contains(snake); died || periodic)
+                ReportProgress(arenaPlayer, snake, died);
+        }
+    }
+
+    void GameServer::ReportProgress(ArenaPlayer & arenaPlayer, const EntitySnake::Shared & snake, const bool lifeEnded)
+    {
+        const auto experience = static_cast<uint32_t>(snake->GetExperience());
+        const auto total = arenaPlayer.banked + (experience > arenaPlayer.lifeStart ? experience - arenaPlayer.lifeStart : 0);
+
+        if (lifeEnded)
+        {
+            arenaPlayer.banked = total;
+            arenaPlayer.lifeStart = experience;
+        }
+
+        if (total == arenaPlayer.reported)
+            return;
+
+        arenaPlayer.reported = total;
+        arenaPlayer.player->Model()->SetExperience(total);
+    }
+
+    void GameServer::PublishSummary()
+    {
+        using Score = Interface::ArenaSummary::Score;
+
+        const auto previous = summary_.load();
+        const auto playersCount = static_cast<uint32_t>(sessions_.size());
+
+        // nobody scored, joined or left since the last one
+        if (previous && previous->version == leaderboard_.Version() && previous->playersCount == playersCount)
+            return;
+
+        auto summary = std::make_shared<Interface::ArenaSummary>();
+        summary->serverID = serverID_;
+        summary->frame = frame_;
+        summary->playersCount = playersCount;
+        summary->version = leaderboard_.Version();
+        summary->topVersion = leaderboard_.TopVersion();
+
+        if (previous && previous->topVersion == summary->topVersion)
+        {
+            summary->top = previous->top;
+            summary->topJson = previous->topJson;
+        }
+        else
+        {
+            auto scores = std::make_shared<std::vector<Score>>();
+            scores->reserve(std::min(leaderboard_.Size(), leaderboard_.TopSize()));
+            leaderboard_.ForEachTop([&](const Leaderboard::Entry & entry)
+            {
+                scores->push_back(Score{ entry.login, entry.experience });
+            });
+
+            boost::json::array top;
+            top.reserve(scores->size());
+            for (const auto & [login, exp] : *scores)
+            {
+                boost::json::object row;
+                row["name"] = login;
+                row["exp"] = exp;
+                top.push_back(std::move(row));
+            }
+
+            summary->top = std::move(scores);
+            summary->topJson = std::make_shared<const std::string>(boost::json::serialize(top));
+        }
+
+        // a join or leave without a score change republishes the same scores
+        if (previous && previous->version == summary->version)
+        {
+            summary->scores = previous->scores;
+        }
+        else
+        {
+            auto scores = std::make_shared<std::unordered_map<std::string, uint32_t>>();
+            scores->reserve(leaderboard_.Size());
+            leaderboard_.ForEach([&](const Leaderboard::Entry & entry)
+            {
+                scores->emplace(entry.login, entry.experience);
+            });
+
+            summary->scores = std::move(scores);
+        }
+
+        summary_.store(std::move(summary));
+    }
 
-        for (auto& [session, snake] : sessions_)
+    void GameServer::SendUpdates(const WorldSnapshot& snapshot)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (const auto& viewer : snapshot.viewers)
         {
             // first: if this session requested snapshot(s), send them out-of-band
-            auto& state = netState_[session];
+            auto& state = netState_[viewer.session];
+            state.netTick++;
             if (!state.pendingSnakeSnapshots.empty())
             {
                 // send a few per tick to avoid worst-case spikes
@@ -55,19 +272,19 @@ namespace Core::App::Game
                 {
                     const auto entityID = *it;
                     it = state.pendingSnakeSnapshots.erase(it);
-                    SendSnakeSnapshot(session, entityID);
+                    SendSnakeSnapshot(snapshot, viewer.session, entityID);
                     sent++;
                 }
             }
 
-            if (fullUpdates_.contains(session))
-                SendFullUpdate(session, snake);
+            if (viewer.fullUpdate)
+                SendFullUpdate(snapshot, viewer);
             else
-                SendPartialUpdate(session, snake);
+                SendPartialUpdate(snapshot, viewer);
         }
-        fullUpdates_.clear();
 
-        udpServer_->ProcessTick();
+        pipelineStats_.networkNs += static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
     }
 
     void GameServer::OnSessionConnected(const UdpSession::Shared & session)
@@ -85,12 +302,19 @@ namespace Core::App::Game
     {
         const auto snake = sessions_[session];
         snakes_.erase(snake);
+        departedSnakes_.push_back(snake->EntityID());
+        leaderboard_.Remove(snake->EntityID());
 
         const auto sessionID = session->SessionId();
+        if (const auto playerIt = players_.find(sessionID); playerIt != players_.end())
+        {
+            ReportProgress(playerIt->second, snake, true);
+            players_.erase(playerIt);
+        }
         sessionsByID_.erase(sessionID);
-        players_.erase(sessionID);
         sessions_.erase(session);
         netState_.erase(session);
+        fullUpdates_.erase(session);
     }
 
     void GameServer::OnMessage(const UdpSession::Shared & session, const std::vector<std::uint8_t>& data)
@@ -106,12 +330,12 @@ namespace Core::App::Game
             return;
         }
 
-        const auto type = static_cast<MessageType>(header.type);
+        const auto sessionIt = sessions_.find(session);
+        if (sessionIt == sessions_.end())
+            return;
 
-        const auto payloadSpan = std::span(
-            data.data() + sizeof(MessageHeader),
-            header.payloadBytes
-        );
+        const auto type = static_cast<MessageType>(header.type);
+        const auto payloadSpan = std::span(data.data() + sizeof(MessageHeader), header.payloadBytes);
 
         if (type == MessageType::RequestFullUpdate)
         {
@@ -123,8 +347,14 @@ namespace Core::App::Game
                 rq.flags = 0;
             }
 
+            // a client without our dictionary could not inflate the payloads; it gets them raw
+            RequestFullUpdateCompression compression{};
+            const bool wantsCompression = (rq.flags & RequestFullUpdateFlag_Compression) != 0 && reader.ReadPod(compression);
+
             auto& state = netState_[session];
             state.fullUpdateAllSegmentsNext = (rq.flags & RequestFullUpdateFlag_AllSegments) != 0;
+            state.compressedPayloads = wantsCompression && compressor_.IsAvailable() && compression.dictionaryID == compressor_.DictionaryID();
+            state.compactEntities = (rq.flags & RequestFullUpdateFlag_CompactEntities) != 0;
 
             fullUpdates_.insert(session);
             return;
@@ -157,36 +387,33 @@ namespace Core::App::Game
                 return;
             }
 
-            const auto snake = sessions_[session];
-            snake->SetDestination({ input.destinationX, input.destinationY });
+            sessionIt->second->SetDestination({ input.destinationX, input.destinationY });
             return;
         }
     }
 
-    void GameServer::SendPartialUpdate(const UdpSession::Shared & session, const EntitySnake::Shared & snake)
+    void GameServer::SendPartialUpdate(const WorldSnapshot& snapshot, const WorldSnapshot::Viewer& viewer)
     {
         using namespace Utils::Legacy::Game::Net;
 
+        const auto& session = viewer.session;
+        const auto& snake = snapshot.snakes[viewer.snake];
+
         auto& state = netState_[session];
         state.updateSeq++;
 
-        const float visibleRadius = EntitySnake::camera_radius * snake->GetZoom();
+        const float visibleRadius = EntitySnake::camera_radius * snake.zoom;
         const float sendRadius = visibleRadius * (1.0f + visibilityPaddingPercent_);
 
         std::unordered_set<std::uint32_t> visibleNow;
-        visibleNow.reserve(snakes_.size() + foods_.size());
+        visibleNow.reserve(snapshot.snakes.size());
 
-        ByteWriter payload(32 * 1024);
+        const auto writer = EntityPayloadWriter::Create(state.compactEntities, 32 * 1024);
 
         // --------- 1) SEND PENDING REMOVES FIRST (retries) ----------
         for (auto it = state.pendingRemoves.begin(); it != state.pendingRemoves.end(); )
         {
-            EntityEntryHeader entry{};
-            entry.type = it->second.type;
-            entry.flags = EntityFlags::Remove;
-            entry.entityID = it->first;
-
-            payload.WritePod(entry);
+            writer->WriteRemove(it->second.type, it->first);
 
             if (it->second.retries > 0)
             {
@@ -221,60 +448,121 @@ namespace Core::App::Game
 
             state.lastHash.erase(entityID);
             state.lastType.erase(entityID);
+            state.lastSentTick.erase(entityID);
+            state.reckoning.erase(entityID);
 
-            EntityEntryHeader entry{};
-            entry.type = pr.type;
-            entry.flags = EntityFlags::Remove;
-            entry.entityID = entityID;
+            writer->WriteRemove(pr.type, entityID);
+        };
 
-            payload.WritePod(entry);
+        // far entities are evaluated every N-th network tick; skipped ones stay visible (no remove)
+        auto IsLodDue = [&](const std::uint32_t entityID, const std::size_t tier)
+        {
+            const auto it = state.lastSentTick.find(entityID);
+            return it == state.lastSentTick.end() || state.netTick - it->second >= lod_.IntervalFor(tier);
         };
 
-        auto ProcessSnakeVisible = [&](const EntitySnake::Shared& s)
+        // true while the client-side extrapolation of the last sent head is still close enough
+        auto IsReckoningAccurate = [&](const SnakeView& s)
         {
-            if (!s || s->IsKilled())
+            const auto it = state.reckoning.find(s.entityID);
+            if (it == state.reckoning.end())
+                return false;
+
+            const auto& r = it->second;
+            const auto elapsed = state.netTick - r.tick;
+
+            if (elapsed > lod_.deadReckoning.maxSuppressed)
+                return false;
+
+            if (r.experience != s.experience || r.totalSegments != s.segmentsCount)
+                return false;
+
+            auto IsPredicted = [&](const sf::Vector2f from, const sf::Vector2f actual)
+            {
+                const auto predicted = from + r.velocity * static_cast<float>(elapsed);
+                return std::hypot(actual.x - predicted.x, actual.y - predicted.y) <= lod_.deadReckoning.threshold;
+            };
+
+            // the head may still be predictable while the body bends; the tail only moves with it when it does not
+            const auto segments = snapshot.Segments(s);
+            return IsPredicted(r.head, s.head) && (segments.empty() || IsPredicted(r.tail, segments.back()));
+        };
+
+        auto ProcessSnakeVisible = [&](const SnakeView& s)
+        {
+            if (s.killed)
                 return;
 
-            if (!IsSnakeVisibleByAnySegment(snake, s, sendRadius))
+            const float distance = GetSnakeDistance(snapshot, snake, s);
+            if (distance > sendRadius)
                 return;
 
-            visibleNow.insert(s->EntityID());
+            visibleNow.insert(s.entityID);
 
-            const bool known = state.lastHash.contains(s->EntityID());
+            const bool known = state.lastHash.contains(s.entityID);
+
+            const auto tier = lod_.TierFor(distance, sendRadius);
+            if (known && !IsLodDue(s.entityID, tier))
+                return;
 
-            EntityEntryHeader entry{};
-            entry.type = EntityType::Snake;
-            entry.entityID = s->EntityID();
+            state.lastSentTick[s.entityID] = state.netTick;
+
+            if (known && lod_.deadReckoning.enabled && IsReckoningAccurate(s))
+            {
+                reckoningSuppressed_++;
+                return;
+            }
+
+            EntityFlags flags;
 
             SnakeState sstate{};
-            sstate.headX = s->GetPosition().x;
-            sstate.headY = s->GetPosition().y;
-            sstate.experience = s->GetExperience();
-            sstate.totalSegments = static_cast<std::uint16_t>(s->Segments().size());
+            sstate.headX = s.head.x;
+            sstate.headY = s.head.y;
+            sstate.experience = s.experience;
+            sstate.totalSegments = static_cast<std::uint16_t>(s.segmentsCount);
 
             std::vector<sf::Vector2f> points;
 
             if (!known)
             {
                 // NEW snake -> send FULL segments in the same packet (may exceed MTU, ok with UDP reassembly)
-                entry.flags = EntityFlags::New;
-                points = GetSnakeFullSegments(s);
+                flags = EntityFlags::New;
+                points = GetSnakeFullSegments(snapshot.Segments(s));
                 sstate.pointsKind = SnakePointsKind::FullSegments;
                 sstate.pointsCount = static_cast<std::uint16_t>(points.size());
             }
             else
             {
-                // UPDATE -> validation samples only (radius-based)
-                entry.flags = EntityFlags::Update;
-                points = SampleSnakeValidationPoints(s);
+                // UPDATE -> validation samples only (radius-based, simplified with distance)
+                flags = EntityFlags::Update;
+                points = lod_.geometry.enabled
+                    ? SampleSnakeValidationPoints(snapshot.Segments(s),
+                                                  s.radius,
+                                                  lod_.geometry.ToleranceFor(distance, sendRadius, snake.zoom),
+                                                  lod_.geometry.maxPoints)
+                    : SampleSnakeValidationPoints(snapshot.Segments(s), s.radius);
                 sstate.pointsKind = SnakePointsKind::ValidationSamples;
                 sstate.pointsCount = static_cast<std::uint16_t>(points.size());
             }
 
-            payload.WritePod(entry);
-            payload.WritePod(sstate);
-            for (const auto& v : points)
-                payload.WriteVector2f(v);
+            lodTierBytes_[tier] += writer->WriteSnake(flags, s.entityID, sstate, points);
+
+            // what the client extrapolates from now on
+            {
+                auto& r = state.reckoning[s.entityID];
+                const auto head = s.head;
+
+                const auto segments = snapshot.Segments(s);
+                r.velocity = (known && r.tick != 0 && state.netTick > r.tick)
+                    ? (head - r.head) / static_cast<float>(state.netTick - r.tick)
+                    : sf::Vector2f{};
+                r.head = head;
+                r.tail = segments.empty() ? head : segments.back();
+                r.tick = state.netTick;
+                r.experience = s.experience;
+                r.totalSegments = s.segmentsCount;
+            }
+            reckoningSent_++;
 
             // hash for delta filtering
             std::uint32_t hash = 0;
@@ -287,16 +575,16 @@ namespace Core::App::Game
 
             if (!known)
             {
-                state.lastHash[s->EntityID()] = hash;
-                state.lastType[s->EntityID()] = EntityType::Snake;
+                state.lastHash[s.entityID] = hash;
+                state.lastType[s.entityID] = EntityType::Snake;
             }
             else
             {
-                const std::uint32_t oldHash = state.lastHash[s->EntityID()];
+                const std::uint32_t oldHash = state.lastHash[s.entityID];
                 if (hash != oldHash)
                 {
-                    state.lastHash[s->EntityID()] = hash;
-                    state.lastType[s->EntityID()] = EntityType::Snake;
+                    state.lastHash[s.entityID] = hash;
+                    state.lastType[s.entityID] = EntityType::Snake;
                 }
                 else
                 {
@@ -306,53 +594,83 @@ namespace Core::App::Game
             }
         };
 
-        auto ProcessFoodVisible = [&](const EntityFood::Shared& f)
+        for (const auto& s : snapshot.snakes)
+            ProcessSnakeVisible(s);
+
+        // --------- FOODS: only chunks that entered the view or changed since the client saw them ---------
+        const auto head = snake.head;
+        const auto& foodChunks = snapshot.foods;
+
+        auto SendFood = [&](const FoodView& f, const std::size_t tier)
         {
-            if (!f || f->IsKilled())
-                return;
+            state.pendingRemoves.erase(f.entityID); // re-entered before the remove retries ran out
+            lodTierBytes_[tier] += writer->WriteFood(EntityFlags::New, f.entityID, f.state);
+        };
 
-            if (!snake->CanSee(f))
-                return;
+        auto RemoveFood = [&](const std::uint32_t entityID)
+        {
+            PendingRemove pr{};
+            pr.type = EntityType::Food;
+            pr.retries = 20;
+            state.pendingRemoves.try_emplace(entityID, pr);
 
-            const auto d = std::hypot(f->GetPosition().x - snake->GetPosition().x,
-                                     f->GetPosition().y - snake->GetPosition().y);
-            if (d > sendRadius)
-                return;
+            writer->WriteRemove(EntityType::Food, entityID);
+        };
 
-            visibleNow.insert(f->EntityID());
+        foodChunks.InRadius(head, sendRadius, chunksInView_);
+        for (const auto index : chunksInView_)
+        {
+            const auto& chunk = foodChunks.Get(index);
+            const auto foods = chunk.Foods();
 
-            FoodState fs{};
-            fs.x = f->GetPosition().x;
-            fs.y = f->GetPosition().y;
-            fs.power = f->GetPower();
-            fs.color = *reinterpret_cast<const Color*>(&f->GetColor());
-            fs.killed = 0;
+            const auto [heldIt, inserted] = state.heldChunks.try_emplace(index);
+            auto& held = heldIt->second;
+            if (!inserted && held.version == chunk.version)
+                continue;
 
-            const std::uint32_t hash = HashBytes(&fs, sizeof(fs));
+            const auto center = foodChunks.CenterOf(index);
+            const auto tier = lod_.TierFor(std::hypot(center.x - head.x, center.y - head.y), sendRadius);
 
-            const bool known = state.lastHash.contains(f->EntityID());
-            const std::uint32_t oldHash = known ? state.lastHash[f->EntityID()] : 0;
+            // merge what the client holds with the chunk contents, both sorted by EntityID
+            std::vector<std::uint32_t> foodIDs;
+            foodIDs.reserve(foods.size());
 
-            if (!known || hash != oldHash)
+            auto h = held.foodIDs.begin();
+            for (const auto& f : foods)
             {
-                EntityEntryHeader entry{};
-                entry.type = EntityType::Food;
-                entry.flags = known ? EntityFlags::Update : EntityFlags::New;
-                entry.entityID = f->EntityID();
-                payload.WritePod(entry);
+                const auto entityID = f.entityID;
+                while (h != held.foodIDs.end() && *h < entityID)
+                    RemoveFood(*h++);
+
+                if (h != held.foodIDs.end() && *h == entityID)
+                    ++h;
+                else
+                    SendFood(f, tier);
 
-                payload.WritePod(fs);
+                foodIDs.push_back(entityID);
+            }
+            while (h != held.foodIDs.end())
+                RemoveFood(*h++);
 
-                state.lastHash[f->EntityID()] = hash;
-                state.lastType[f->EntityID()] = EntityType::Food;
+            held.version = chunk.version;
+            held.foodIDs = std::move(foodIDs);
+        }
+
+        // chunks are dropped a bit later than they are picked up, so moving along a chunk edge does not thrash
+        foodChunks.InRadius(head, sendRadius * 1.1f, chunksRetained_);
+        for (auto it = state.heldChunks.begin(); it != state.heldChunks.end(); )
+        {
+            if (std::ranges::binary_search(chunksRetained_, it->first))
+            {
+                ++it;
+                continue;
             }
-        };
 
-        for (const auto& s : snakes_)
-            ProcessSnakeVisible(s);
+            for (const auto entityID : it->second.foodIDs)
+                RemoveFood(entityID);
 
-        for (const auto& f : foods_)
-            ProcessFoodVisible(f);
+            it = state.heldChunks.erase(it);
+        }
 
         // --------- 2) REMOVES: anything that was visible, but now not visible ---------
         for (const auto oldID : state.lastVisible)
@@ -365,70 +683,71 @@ namespace Core::App::Game
 
         state.lastVisible = std::move(visibleNow);
 
-        if (payload.Data().empty())
+        if (!writer->HasEntities())
         {
             return;
         }
 
+        const auto& data = writer->Finish();
+        RecordEntityPayload(*writer, data.size());
+
         const auto msg = BuildMessage(MessageType::PartialUpdate,
                                       state.updateSeq,
-                                      frame_,
-                                      payload.Data());
+                                      snapshot.frame,
+                                      data);
 
         session->Send(msg);
     }
 
-    void GameServer::SendFullUpdate(const UdpSession::Shared & session, const EntitySnake::Shared & snake)
+    void GameServer::SendFullUpdate(const WorldSnapshot& snapshot, const WorldSnapshot::Viewer& viewer)
     {
         using namespace Utils::Legacy::Game::Net;
 
+        const auto& session = viewer.session;
+        const auto& snake = snapshot.snakes[viewer.snake];
+
         auto& state = netState_[session];
         state.updateSeq++;
 
-        const float visibleRadius = EntitySnake::camera_radius * snake->GetZoom();
+        const float visibleRadius = EntitySnake::camera_radius * snake.zoom;
         const float sendRadius = visibleRadius * (1.0f + visibilityPaddingPercent_);
 
         std::unordered_set<std::uint32_t> visibleNow;
-        visibleNow.reserve(snakes_.size() + foods_.size());
+        visibleNow.reserve(snapshot.snakes.size());
 
-        ByteWriter payload(128 * 1024);
-        WriteFullUpdateHeader(payload, snake->EntityID());
+        const auto writer = EntityPayloadWriter::Create(state.compactEntities, 128 * 1024);
+        WriteFullUpdateHeader(writer->Prefix(), snake.entityID);
 
         // snapshot baseline
         state.lastHash.clear();
         state.lastType.clear();
+        state.lastSentTick.clear();
+        state.reckoning.clear();
+        state.heldChunks.clear();
         state.pendingRemoves.clear();
 
-        auto AddSnake = [&](const EntitySnake::Shared& s)
+        auto AddSnake = [&](const SnakeView& s)
         {
-            if (!s || s->IsKilled())
+            if (s.killed)
                 return;
 
-            if (!IsSnakeVisibleByAnySegment(snake, s, sendRadius))
+            if (!IsSnakeVisibleByAnySegment(snapshot, snake, s, sendRadius))
                 return;
 
-            visibleNow.insert(s->EntityID());
-
-            EntityEntryHeader entry{};
-            entry.type = EntityType::Snake;
-            entry.flags = EntityFlags::New;
-            entry.entityID = s->EntityID();
-            payload.WritePod(entry);
+            visibleNow.insert(s.entityID);
 
             SnakeState sstate{};
-            sstate.headX = s->GetPosition().x;
-            sstate.headY = s->GetPosition().y;
-            sstate.experience = s->GetExperience();
-            sstate.totalSegments = static_cast<std::uint16_t>(s->Segments().size());
+            sstate.headX = s.head.x;
+            sstate.headY = s.head.y;
+            sstate.experience = s.experience;
+            sstate.totalSegments = static_cast<std::uint16_t>(s.segmentsCount);
 
             // FullUpdate: ALWAYS send full segments for every visible snake (fixes "6 parts" issue)
-            const auto points = GetSnakeFullSegments(s);
+            const auto points = GetSnakeFullSegments(snapshot.Segments(s));
             sstate.pointsKind = SnakePointsKind::FullSegments;
             sstate.pointsCount = static_cast<std::uint16_t>(points.size());
 
-            payload.WritePod(sstate);
-            for (const auto& v : points)
-                payload.WriteVector2f(v);
+            writer->WriteSnake(EntityFlags::New, s.entityID, sstate, points);
 
             std::uint32_t hash = 0;
             hash ^= HashBytes(&sstate, sizeof(sstate));
@@ -438,84 +757,65 @@ namespace Core::App::Game
                 hash ^= HashBytes(&v.y, sizeof(v.y));
             }
 
-            state.lastHash[s->EntityID()] = hash;
-            state.lastType[s->EntityID()] = EntityType::Snake;
+            state.lastHash[s.entityID] = hash;
+            state.lastType[s.entityID] = EntityType::Snake;
+            state.lastSentTick[s.entityID] = state.netTick;
+
+            state.reckoning[s.entityID] = SnakeReckoning{
+                .head = s.head,
+                .tail = s.segmentsCount ? snapshot.Segments(s).back() : s.head,
+                .velocity = {},
+                .tick = state.netTick,
+                .experience = s.experience,
+                .totalSegments = s.segmentsCount,
+            };
         };
 
-        auto AddFood = [&](const EntityFood::Shared& f)
-        {
-            if (!f || f->IsKilled())
-                return;
-
-            if (!snake->CanSee(f))
-                return;
-
-            const auto d = std::hypot(f->GetPosition().x - snake->GetPosition().x,
-                                     f->GetPosition().y - snake->GetPosition().y);
-            if (d > sendRadius)
-                return;
-
-            visibleNow.insert(f->EntityID());
-
-            EntityEntryHeader entry{};
-            entry.type = EntityType::Food;
-            entry.flags = EntityFlags::New;
-            entry.entityID = f->EntityID();
-            payload.WritePod(entry);
-
-            FoodState fs{};
-            fs.x = f->GetPosition().x;
-            fs.y = f->GetPosition().y;
-            fs.power = f->GetPower();
-            fs.color = *reinterpret_cast<const Color*>(&f->GetColor());
-            fs.killed = 0;
-
-            payload.WritePod(fs);
+        for (const auto& s : snapshot.snakes)
+            AddSnake(s);
 
-            const std::uint32_t hash = HashBytes(&fs, sizeof(fs));
-            state.lastHash[f->EntityID()] = hash;
-            state.lastType[f->EntityID()] = EntityType::Food;
-        };
+        snapshot.foods.InRadius(snake.head, sendRadius, chunksInView_);
+        for (const auto index : chunksInView_)
+        {
+            const auto& chunk = snapshot.foods.Get(index);
+            const auto foods = chunk.Foods();
 
-        for (const auto& s : snakes_)
-            AddSnake(s);
+            auto& held = state.heldChunks[index];
+            held.version = chunk.version;
+            held.foodIDs.reserve(foods.size());
 
-        for (const auto& f : foods_)
-            AddFood(f);
+            for (const auto& f : foods)
+            {
+                writer->WriteFood(EntityFlags::New, f.entityID, f.state);
+                held.foodIDs.push_back(f.entityID);
+            }
+        }
 
         state.lastVisible = std::move(visibleNow);
 
-        const auto msg = BuildMessage(MessageType::FullUpdate,
-                                      state.updateSeq,
-                                      frame_,
-                                      payload.Data());
+        const auto& data = writer->Finish();
+        RecordEntityPayload(*writer, data.size());
 
-        session->Send(msg);
+        compressor_.Capture("full_update", data);
+        SendCompressible(session, state, MessageType::FullUpdate, snapshot.frame, data);
 
         state.fullUpdateAllSegmentsNext = false;
     }
 
-    void GameServer::SendSnakeSnapshot(const UdpSession::Shared& session, const std::uint32_t entityID)
+    void GameServer::SendSnakeSnapshot(const WorldSnapshot& snapshot, const UdpSession::Shared& session, const std::uint32_t entityID)
     {
         using namespace Utils::Legacy::Game::Net;
 
         // find snake by entityID (visible or not - snapshot used for repair, but we still send full data if exists)
-        EntitySnake::Shared targetSnake;
-        for (const auto& s : snakes_)
-        {
-            if (s && s->EntityID() == entityID && !s->IsKilled())
-            {
-                targetSnake = s;
-                break;
-            }
-        }
-
-        if (!targetSnake)
+        const auto index = snapshot.IndexOf(entityID);
+        if (!index || snapshot.snakes[*index].killed)
         {
             // if snake doesn't exist (already removed), send nothing.
             return;
         }
 
+        const auto& targetSnake = snapshot.snakes[*index];
+
         ByteWriter payload(64 * 1024);
 
         EntityEntryHeader entry{};
@@ -525,12 +825,12 @@ namespace Core::App::Game
         payload.WritePod(entry);
 
         SnakeState sstate{};
-        sstate.headX = targetSnake->GetPosition().x;
-        sstate.headY = targetSnake->GetPosition().y;
-        sstate.experience = targetSnake->GetExperience();
-        sstate.totalSegments = static_cast<std::uint16_t>(targetSnake->Segments().size());
+        sstate.headX = targetSnake.head.x;
+        sstate.headY = targetSnake.head.y;
+        sstate.experience = targetSnake.experience;
+        sstate.totalSegments = static_cast<std::uint16_t>(targetSnake.segmentsCount);
 
-        const auto points = GetSnakeFullSegments(targetSnake);
+        const auto points = GetSnakeFullSegments(snapshot.Segments(targetSnake));
         sstate.pointsKind = SnakePointsKind::FullSegments;
         sstate.pointsCount = static_cast<std::uint16_t>(points.size());
 
@@ -541,14 +841,80 @@ namespace Core::App::Game
         auto& state = netState_[session];
         state.updateSeq++;
 
-        const auto msg = BuildMessage(MessageType::SnakeSnapshot,
+        compressor_.Capture("snake_snapshot", payload.Data());
+        SendCompressible(session, state, MessageType::SnakeSnapshot, snapshot.frame, payload.Data());
+    }
+
+    void GameServer::SendCompressible(const UdpSession::Shared& session,
+                                      const SessionNetState& state,
+                                      const Utils::Legacy::Game::Net::MessageType type,
+                                      const std::uint64_t frame,
+                                      const std::vector<std::uint8_t>& payload)
+    {
+        using namespace Utils::Legacy::Game::Net;
+
+        thread_local std::vector<std::uint8_t> compressed;
+
+        const bool useCompressed = state.compressedPayloads && compressor_.Compress(payload, compressed);
+
+        const auto msg = BuildMessage(useCompressed ? CompressedType(type) : type,
                                       state.updateSeq,
-                                      frame_,
-                                      payload.Data());
+                                      frame,
+                                      useCompressed ? compressed : payload);
 
         session->Send(msg);
     }
 
+    void GameServer::RecordEntityPayload(const EntityPayloadWriter& writer, const std::size_t bytes)
+    {
+        if (const auto compact = dynamic_cast<const CompactEntityWriter*>(&writer))
+        {
+            compactBytes_ += bytes;
+            compactLegacyBytes_ += compact->LegacyBytes();
+        }
+    }
+
+    void GameServer::LogNetStats() const
+    {
+        if (const auto ticks = pipelineStats_.ticks)
+        {
+            const auto Micros = [ticks](const std::uint64_t ns) { return static_cast<double>(ns) / 1000.0 / static_cast<double>(ticks); };
+
+            Log()->Debug("[Net] Pipeline per network tick: simulate={:.1f}us publish={:.1f}us wait={:.1f}us network={:.1f}us ({})",
+                         Micros(pipelineStats_.simulateNs), Micros(pipelineStats_.publishNs),
+                         Micros(pipelineStats_.waitNs), Micros(pipelineStats_.networkNs),
+                         networkStage_.IsThreaded() ? "threaded" : "inline");
+        }
+
+        for (std::size_t tier = 0; tier < lodTierBytes_.size(); ++tier)
+        {
+            Log()->Debug("[Net] LOD tier {} (<= {:.2f} radius, every {} ticks): {}B",
+                         tier, lod_.tiers[tier].distanceFactor, lod_.tiers[tier].interval, lodTierBytes_[tier]);
+        }
+
+        if (reckoningSent_ + reckoningSuppressed_)
+        {
+            Log()->Debug("[Net] Dead reckoning: sent={} suppressed={} ({:.1f}%)",
+                         reckoningSent_, reckoningSuppressed_,
+                         100.0 * static_cast<double>(reckoningSuppressed_) / static_cast<double>(reckoningSent_ + reckoningSuppressed_));
+        }
+
+        if (compactBytes_)
+        {
+            Log()->Debug("[Net] Compact entities: {}B (legacy encoding {}B, {:.1f}%)",
+                         compactBytes_, compactLegacyBytes_,
+                         100.0 * static_cast<double>(compactBytes_) / static_cast<double>(compactLegacyBytes_));
+        }
+
+        const auto & stats = compressor_.Stats();
+        if (!stats.messages)
+            return;
+
+        Log()->Debug("[Net] Compression: messages={} skipped={} raw={}B compressed={}B ratio={:.2f} encode={:.1f}us/msg dict={}",
+                     stats.messages, stats.skipped, stats.rawBytes, stats.compressedBytes,
+                     stats.Ratio(), stats.EncodeMicrosPerMessage(), compressor_.DictionaryID());
+    }
+
     void GameServer::ProcessSnake(const EntitySnake::Shared & snake)
     {
         if (snake->IsKilled())
@@ -574,6 +940,7 @@ namespace Core::App::Game
                                snake->GetRadius(true) + food->GetRadius()))
             {
                 snake->AddExperience(food->GetPower());
+                foodChunks_.Remove(food);
                 return true;
             }
 
@@ -605,6 +972,8 @@ namespace Core::App::Game
         }
 
         snake->RecalculateLength();
+
+        leaderboard_.Update(snake->EntityID(), snake->GetExperience());
     }
 
     void GameServer::RespawnSnake(const EntitySnake::Shared & snake)
@@ -618,6 +987,10 @@ namespace Core::App::Game
             if (sessionSnake == snake)
             {
                 fullUpdates_.insert(session);
+                TrackScore(session, snake);
+
+                if (const auto playerIt = players_.find(session->SessionId()); playerIt != players_.end())
+                    playerIt->second.lifeStart = snake->GetExperience();
                 break;
             }
         }
@@ -630,6 +1003,7 @@ namespace Core::App::Game
 
         snake->Kill(frame_);
         killedSnakes_.insert(snake);
+        leaderboard_.Remove(snake->EntityID());
     }
 
     void GameServer::ProcessKills()
@@ -650,9 +1024,7 @@ namespace Core::App::Game
                 const float spawnRadius = randomIndex == 0 ? snake->GetRadius(true) : snake->GetRadius(false);
                 const sf::Vector2f position = GetRandomVector2fInSphere(segmentPosition, spawnRadius);
 
-                auto food = std::make_shared<EntityFood>(frame_, position, 10);
-                food->SetEntityID(nextEntityID_++);
-                foods_.insert(food);
+                SpawnFood(std::make_shared<EntityFood>(frame_, position, 10));
             }
         }
 
@@ -664,12 +1036,28 @@ namespace Core::App::Game
         for (auto i = foods_.size(); i < Utils::Legacy::Game::FoodCount; i++)
         {
             const auto position = GetRandomVector2fInSphere(Utils::Legacy::Game::AreaCenter, Utils::Legacy::Game::AreaRadius - 10.f);
-            auto food = std::make_shared<EntityFood>(frame_, position);
-            food->SetEntityID(nextEntityID_++);
-            foods_.insert(food);
+            SpawnFood(std::make_shared<EntityFood>(frame_, position));
         }
     }
 
+    void GameServer::SpawnFood(const EntityFood::Shared & food)
+    {
+        food->SetEntityID(nextEntityID_++);
+        foods_.insert(food);
+        foodChunks_.Add(food);
+    }
+
+    void GameServer::SyncFoodChunks()
+    {
+        // every spawn (SpawnFood) and eat (ProcessSnake) updates the chunks in place,
+        // so this only guards foods_ against Logic; the count is enough for that and costs nothing per tick
+        if (foodChunks_.Count() == foods_.size())
+            return;
+
+        Log()->Debug("[Net] Food chunks out of sync ({} vs {} foods), rebuilding", foodChunks_.Count(), foods_.size());
+        foodChunks_.Rebuild(foods_);
+    }
+
     uint32_t GameServer::GetServerID() const
     {
         return serverID_;
@@ -677,10 +1065,38 @@ namespace Core::App::Game
 
     uint32_t GameServer::GetPlayersCount() const
     {
-        return sessions_.size();
+        return GetSummary()->playersCount;
+    }
+
+    void GameServer::Post(std::function<void()> job)
+    {
+        std::lock_guard lock(inboxMutex_);
+        inbox_.push_back(std::move(job));
+    }
+
+    void GameServer::DrainInbox()
+    {
+        {
+            std::lock_guard lock(inboxMutex_);
+            if (inbox_.empty())
+                return;
+
+            inboxDrain_.swap(inbox_);
+        }
+
+        for (const auto & job : inboxDrain_)
+            job();
+
+        inboxDrain_.clear();
     }
 
     void GameServer::SetSSIDPlayer(const uint64_t ssid, const Player::Shared & player)
+    {
+        // any thread: the arena state is only touched from its own tick
+        Post([this, ssid, player] { ApplySSIDPlayer(ssid, player); });
+    }
+
+    void GameServer::ApplySSIDPlayer(const uint64_t ssid, const Player::Shared & player)
     {
         Log()->Debug("SetSSIDPlayer serverId {} session {} connected with {}", serverID_, ssid, player->Model()->GetLogin());
 
@@ -701,30 +1117,25 @@ namespace Core::App::Game
         //     }
         // }
 
-        players_[ssid] = player;
-    }
-
-    std::unordered_map<Player::Shared, uint32_t> GameServer::GetLeaderboard()
-    {
-        std::unordered_map<Player::Shared, uint32_t> leaderboard;
-
-        Log()->Debug("GetLeaderboard: {} {}", serverID_, players_.size());
+        const auto experience = player->Model()->GetExperience();
+        auto & arenaPlayer = players_[ssid] = ArenaPlayer{
+            .player = player,
+            .login = player->Model()->GetLogin(),
+            .banked = experience,
+            .reported = experience,
+        };
 
-        for (const auto & [ssid, player] : players_)
+        if (const auto sessionIt = sessionsByID_.find(ssid); sessionIt != sessionsByID_.end())
         {
-            if (!sessionsByID_.contains(ssid))
-                continue;
-
-            const auto session = sessionsByID_[ssid];
-
-            const auto snake = sessions_[session];
-            if (!snake->IsKilled())
-            {
-                leaderboard[player] = snake->GetExperience();
-            }
+            const auto & snake = sessions_.at(sessionIt->second);
+            arenaPlayer.lifeStart = snake->GetExperience(); // only what is gained from now on counts
+            TrackScore(sessionIt->second, snake);
         }
+    }
 
-        return leaderboard;
+    Interface::ArenaSummary::Shared GameServer::GetSummary() const
+    {
+        return summary_.load();
     }
 
     GameServer::Shared GameServer::Create(const BaseServiceContainer * parent, const uint8_t serverID)
@@ -742,31 +1153,24 @@ namespace Core::App::Game
         return crc.checksum();
     }
 
-    std::vector<sf::Vector2f> GetSnakeFullSegments(const Utils::Legacy::Game::Entity::Snake::Shared& snake)
+    std::vector<sf::Vector2f> GetSnakeFullSegments(const std::span<const sf::Vector2f> segments)
     {
-        std::vector<sf::Vector2f> out;
-        const auto& segments = snake->Segments();
-        out.assign(segments.begin(), segments.end());
-        return out;
+        return { segments.begin(), segments.end() };
     }
 
-    std::vector<sf::Vector2f> SampleSnakeValidationPoints(const Utils::Legacy::Game::Entity::Snake::Shared& snake)
+    std::vector<sf::Vector2f> SampleSnakeValidationPoints(const std::span<const sf::Vector2f> segVec, const float minDist)
     {
         std::vector<sf::Vector2f> out;
 
-        const auto& segments = snake->Segments();
-        if (segments.empty())
+        if (segVec.empty())
         {
             return out;
         }
 
-        const std::vector<sf::Vector2f> segVec(segments.begin(), segments.end());
         const std::size_t n = segVec.size();
 
         out.reserve(n);
 
-        const float minDist = snake->GetRadius(false);
-
         sf::Vector2f last = segVec[0];
         out.push_back(last);
 
@@ -797,25 +1201,143 @@ namespace Core::App::Game
         return out;
     }
 
-    bool IsSnakeVisibleByAnySegment(const EntitySnake::Shared& viewer, const EntitySnake::Shared& target, const float radius)
+    std::vector<sf::Vector2f> SampleSnakeValidationPoints(const std::span<const sf::Vector2f> segments,
+                                                          const float minDistance,
+                                                          const float tolerance,
+                                                          const std::size_t maxPoints)
     {
-        if (!viewer || !target)
-            return false;
+        auto out = SimplifyPolyline(SampleSnakeValidationPoints(segments, minDistance), tolerance);
+        CapPolylinePoints(out, maxPoints);
+        return out;
+    }
+
+    std::vector<sf::Vector2f> SimplifyPolyline(const std::vector<sf::Vector2f>& points, const float tolerance)
+    {
+        const std::size_t n = points.size();
+        if (n <= 2 || tolerance <= 0.0f)
+        {
+            return points;
+        }
+
+        std::vector<bool> keep(n, false);
+        keep.front() = true;
+        keep.back() = true;
+
+        const float tolerance2 = tolerance * tolerance;
+
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        stack.emplace_back(0, n - 1);
+
+        while (!stack.empty())
+        {
+            const auto [first, last] = stack.back();
+            stack.pop_back();
+
+            const auto& a = points[first];
+            const auto& b = points[last];
+            const float abx = b.x - a.x;
+            const float aby = b.y - a.y;
+            const float abLen2 = abx * abx + aby * aby;
+
+            float maxDist2 = 0.0f;
+            std::size_t maxIndex = first;
+
+            for (std::size_t i = first + 1; i < last; ++i)
+            {
+                const float apx = points[i].x - a.x;
+                const float apy = points[i].y - a.y;
+
+                float dist2;
+                if (abLen2 <= 0.0f)
+                {
+                    dist2 = apx * apx + apy * apy;
+                }
+                else
+                {
+                    // squared distance to segment a-b
+                    const float t = std::clamp((apx * abx + apy * aby) / abLen2, 0.0f, 1.0f);
+                    const float dx = apx - t * abx;
+                    const float dy = apy - t * aby;
+                    dist2 = dx * dx + dy * dy;
+                }
+
+                if (dist2 > maxDist2)
+                {
+                    maxDist2 = dist2;
+                    maxIndex = i;
+                }
+            }
+
+            if (maxDist2 > tolerance2)
+            {
+                keep[maxIndex] = true;
+                stack.emplace_back(first, maxIndex);
+                stack.emplace_back(maxIndex, last);
+            }
+        }
+
+        std::vector<sf::Vector2f> out;
+        out.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (keep[i])
+                out.push_back(points[i]);
+        }
+
+        return out;
+    }
+
+    void CapPolylinePoints(std::vector<sf::Vector2f>& points, const std::size_t maxPoints)
+    {
+        if (maxPoints < 2 || points.size() <= maxPoints)
+        {
+            return;
+        }
+
+        const std::size_t n = points.size();
+        std::vector<sf::Vector2f> out;
+        out.reserve(maxPoints);
+
+        for (std::size_t i = 0; i < maxPoints; ++i)
+        {
+            out.push_back(points[i * (n - 1) / (maxPoints - 1)]);
+        }
+
+        points = std::move(out);
+    }
+
+    float GetSnakeDistance(const WorldSnapshot& snapshot, const SnakeView& viewer, const SnakeView& target)
+    {
+        const auto viewerPos = viewer.head; // viewer head
 
-        const auto viewerPos = viewer->GetPosition(); // viewer head
+        const auto head = target.head;
+        float best = (head.x - viewerPos.x) * (head.x - viewerPos.x) + (head.y - viewerPos.y) * (head.y - viewerPos.y);
+
+        for (const auto& seg : snapshot.Segments(target))
+        {
+            const float dx = seg.x - viewerPos.x;
+            const float dy = seg.y - viewerPos.y;
+            best = std::min(best, dx * dx + dy * dy);
+        }
+
+        return std::sqrt(best);
+    }
+
+    bool IsSnakeVisibleByAnySegment(const WorldSnapshot& snapshot, const SnakeView& viewer, const SnakeView& target, const float radius)
+    {
+        const auto viewerPos = viewer.head; // viewer head
         const float r2 = radius * radius;
 
         // Check head first (fast path)
         {
-            const auto head = target->GetPosition();
+            const auto head = target.head;
             const float dx = head.x - viewerPos.x;
             const float dy = head.y - viewerPos.y;
             if ((dx * dx + dy * dy) <= r2)
                 return true;
         }
 
-        const auto& segments = target->Segments();
-        for (const auto& seg : segments)
+        for (const auto& seg : snapshot.Segments(target))
         {
             const float dx = seg.x - viewerPos.x;
             const float dy = seg.y - viewerPos.y;
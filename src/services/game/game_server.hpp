@@ -2,9 +2,23 @@
 
 #include "interfaces/game_server.hpp"
 
+#include "entity_codec.hpp"
+#include "food_chunks.hpp"
+#include "leaderboard.hpp"
+#include "net_lod.hpp"
+#include "payload_compressor.hpp"
+#include "protocol_ext.hpp"
+#include "stage_worker.hpp"
+#include "world_snapshot.hpp"
+
 #include "game_messages.hpp"
 #include "udp.hpp"
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -29,7 +43,18 @@ namespace Core::App::Game
 
         std::unordered_map<UdpSession::Shared, EntitySnake::Shared> sessions_;
         std::unordered_map<uint64_t, UdpSession::Shared> sessionsByID_;
-        std::unordered_map<uint64_t, Player::Shared> players_;
+        struct ArenaPlayer
+        {
+            Player::Shared player;
+            std::string login; // captured on assignment, read every tick by PublishSummary
+
+            // account experience, written behind by the player model
+            uint32_t banked { 0 };    // at the start of the current life
+            uint32_t lifeStart { 0 }; // snake experience the current life started with
+            uint32_t reported { 0 };
+        };
+
+        std::unordered_map<uint64_t, ArenaPlayer> players_;
         std::unordered_set<EntitySnake::Shared> killedSnakes_;
 
         std::unordered_set<UdpSession::Shared> fullUpdates_;
@@ -40,19 +65,43 @@ namespace Core::App::Game
             std::uint8_t retries { 0 };
         };
 
+        struct SnakeReckoning
+        {
+            sf::Vector2f head {};
+            sf::Vector2f tail {};      // last body segment sent with it
+            sf::Vector2f velocity {};  // per network tick
+            std::uint32_t tick { 0 };  // netTick of the last sent head
+            std::uint32_t experience { 0 };
+            std::size_t totalSegments { 0 };
+        };
+
+        struct HeldChunk
+        {
+            std::uint32_t version { 0 };
+            std::vector<std::uint32_t> foodIDs; // sorted
+        };
+
         struct SessionNetState
         {
-            std::uint32_t updateSeq { 0 };
+            std::uint32_t updateSeq { 0 }; // every message sent, snapshots included
+            std::uint32_t netTick { 0 };   // SendUpdates passes, the clock of LOD and dead reckoning
 
             std::unordered_set<std::uint32_t> lastVisible; // EntityID
             std::unordered_map<std::uint32_t, std::uint32_t> lastHash; // EntityID -> hash
             std::unordered_map<std::uint32_t, Utils::Legacy::Game::Net::EntityType> lastType; // EntityID -> type
+            std::unordered_map<std::uint32_t, std::uint32_t> lastSentTick; // EntityID -> netTick of the last evaluation (LOD)
+            std::unordered_map<std::uint32_t, SnakeReckoning> reckoning; // EntityID -> what the client extrapolates from
+
+            std::unordered_map<std::uint32_t, HeldChunk> heldChunks; // food chunk index -> what the client holds
 
             std::unordered_map<std::uint32_t, PendingRemove> pendingRemoves;
 
             bool fullUpdateAllSegmentsNext { false }; // kept for compatibility; FullUpdate now always sends full segments
 
             std::unordered_set<std::uint32_t> pendingSnakeSnapshots; // entityIDs to snapshot next tick
+
+            bool compressedPayloads { false }; // negotiated via RequestFullUpdateFlag_Compression, same dictionary on both ends
+            bool compactEntities { false };    // negotiated via RequestFullUpdateFlag_CompactEntities
         };
 
         std::unordered_map<UdpSession::Shared, SessionNetState> netState_;
@@ -60,7 +109,49 @@ namespace Core::App::Game
 
         float visibilityPaddingPercent_ { 0.20f };
 
+        PayloadCompressor compressor_;
+
+        FoodChunks foodChunks_;
+        std::vector<std::uint32_t> chunksInView_, chunksRetained_; // scratch
+
+        NetLodConfig lod_;
+        std::vector<std::uint64_t> lodTierBytes_; // bytes written per LOD tier
+
+        std::uint64_t reckoningSent_ { 0 };
+        std::uint64_t reckoningSuppressed_ { 0 };
+
+        std::uint64_t compactBytes_ { 0 };
+        std::uint64_t compactLegacyBytes_ { 0 };
+
+        struct PipelineStats
+        {
+            std::uint64_t ticks { 0 };      // network ticks
+            std::uint64_t simulateNs { 0 }; // Logic + ProcessSnake / kills / food, both logic ticks
+            std::uint64_t publishNs { 0 };  // snapshot copy + viewer assignment
+            std::uint64_t waitNs { 0 };     // simulation blocked on the network stage
+            std::uint64_t networkNs { 0 };  // serialization + send, on the network stage
+        };
+
+        PipelineStats pipelineStats_;
+
+        // tick N is sent from one snapshot while tick N + 1 is written into the other
+        std::array<WorldSnapshot, 2> snapshots_;
+        std::size_t backSnapshot_ { 0 };
+
+        std::vector<std::uint32_t> departedSnakes_; // EntityIDs whose session left after the snapshot was built
+
         uint32_t serverID_ = 0;
+
+        Leaderboard leaderboard_;
+        std::atomic<Interface::ArenaSummary::Shared> summary_;
+
+        // calls from other threads (websocket handlers), applied at the start of the next tick
+        std::mutex inboxMutex_;
+        std::vector<std::function<void()>> inbox_;
+        std::vector<std::function<void()>> inboxDrain_;
+
+        // last member: joined before the state its jobs touch is destroyed
+        StageWorker networkStage_;
     public:
         using Shared = std::shared_ptr<GameServer>;
 
@@ -77,11 +168,24 @@ namespace Core::App::Game
 
         void OnMessage(const UdpSession::Shared & session, const std::vector<std::uint8_t>& data) override;
 
-        void SendPartialUpdate(const UdpSession::Shared & session, const EntitySnake::Shared & snake);
+        // network stage: reads only the snapshot and netState_
+        void SendUpdates(const WorldSnapshot & snapshot);
+
+        void SendPartialUpdate(const WorldSnapshot & snapshot, const WorldSnapshot::Viewer & viewer);
+
+        void SendFullUpdate(const WorldSnapshot & snapshot, const WorldSnapshot::Viewer & viewer);
 
-        void SendFullUpdate(const UdpSession::Shared & session, const EntitySnake::Shared & snake);
+        void SendSnakeSnapshot(const WorldSnapshot & snapshot, const UdpSession::Shared& session, std::uint32_t entityID);
 
-        void SendSnakeSnapshot(const UdpSession::Shared& session, std::uint32_t entityID);
+        void SendCompressible(const UdpSession::Shared& session,
+                              const SessionNetState& state,
+                              Utils::Legacy::Game::Net::MessageType type,
+                              std::uint64_t frame,
+                              const std::vector<std::uint8_t>& payload);
+
+        void RecordEntityPayload(const EntityPayloadWriter& writer, std::size_t bytes);
+
+        void LogNetStats() const;
 
     public:
         void ProcessSnake(const EntitySnake::Shared & snake);
@@ -94,6 +198,30 @@ namespace Core::App::Game
 
         void GenerateFoods();
 
+        // the only way food enters foods_, keeps foodChunks_ in step
+        void SpawnFood(const EntityFood::Shared & food);
+
+        void SyncFoodChunks();
+
+        void BuildSnapshot(WorldSnapshot & snapshot) const;
+
+        void AssignViewers(WorldSnapshot & snapshot);
+
+        void TrackScore(const UdpSession::Shared & session, const EntitySnake::Shared & snake);
+
+        // deaths every network tick, living snakes once a second
+        void ReportExperience();
+
+        void ReportProgress(ArenaPlayer & arenaPlayer, const EntitySnake::Shared & snake, bool lifeEnded);
+
+        void Post(std::function<void()> job);
+
+        void DrainInbox();
+
+        void ApplySSIDPlayer(uint64_t ssid, const Player::Shared & player);
+
+        void PublishSummary();
+
     public:
         [[nodiscard]] uint32_t GetServerID() const override;
 
@@ -101,7 +229,7 @@ namespace Core::App::Game
 
         void SetSSIDPlayer(uint64_t ssid, const Player::Shared & player) override;
 
-        std::unordered_map<Player::Shared, uint32_t> GetLeaderboard() override;
+        [[nodiscard]] Interface::ArenaSummary::Shared GetSummary() const override;
 
         static Shared Create(const BaseServiceContainer * parent, std::uint8_t serverID);
     private:
@@ -114,9 +242,25 @@ namespace Core::App::Game
     // state hashes for delta filtering
     std::uint32_t HashBytes(const void* data, std::size_t size);
 
-    std::vector<sf::Vector2f> GetSnakeFullSegments(const Utils::Legacy::Game::Entity::Snake::Shared& snake);
+    std::vector<sf::Vector2f> GetSnakeFullSegments(std::span<const sf::Vector2f> segments);
+
+    // points at least `minDistance` (body radius) apart, head and tail always kept
+    std::vector<sf::Vector2f> SampleSnakeValidationPoints(std::span<const sf::Vector2f> segments, float minDistance);
+
+    // validation samples simplified within `tolerance` (world units), at most `maxPoints` of them
+    std::vector<sf::Vector2f> SampleSnakeValidationPoints(std::span<const sf::Vector2f> segments,
+                                                          float minDistance,
+                                                          float tolerance,
+                                                          std::size_t maxPoints);
+
+    // Douglas-Peucker, keeps first and last point
+    std::vector<sf::Vector2f> SimplifyPolyline(const std::vector<sf::Vector2f>& points, float tolerance);
+
+    // uniform resample down to maxPoints, keeps first and last point
+    void CapPolylinePoints(std::vector<sf::Vector2f>& points, std::size_t maxPoints);
 
-    std::vector<sf::Vector2f> SampleSnakeValidationPoints(const Utils::Legacy::Game::Entity::Snake::Shared& snake);
+    // distance from the viewer head to the closest point (head or segment) of the target
+    float GetSnakeDistance(const WorldSnapshot& snapshot, const SnakeView& viewer, const SnakeView& target);
 
-    bool IsSnakeVisibleByAnySegment(const EntitySnake::Shared& viewer, const EntitySnake::Shared& target, float radius);
+    bool IsSnakeVisibleByAnySegment(const WorldSnapshot& snapshot, const SnakeView& viewer, const SnakeView& target, float radius);
 }
\ No newline at end of file
@@ -5,8 +5,19 @@
 
 #include "coroutine.hpp"
 
+#include <format>
+#include <string>
+
 namespace Core::App::Game
 {
+    // websocket topics the controller pushes arena changes to
+    inline std::string LeaderboardTopic(const uint32_t serverID)
+    {
+        return std::format("leaderboard:{}", serverID);
+    }
+
+    inline const std::string StatsTopic = "stats";
+
     namespace Interface
     {
         class Controller: public BaseServiceInterface, public BaseServiceInstance
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "[core_loader].hpp"
 
@@ -18,6 +23,52 @@ namespace Core::App::Game
     using Player = PlayerSession::Interface::Player;
 
     namespace Interface {
+        // Immutable per-arena view, published by the arena every network tick.
+        // Safe to read from any thread; holds copies only, never live game or session objects.
+        struct ArenaSummary
+        {
+            using Shared = std::shared_ptr<const ArenaSummary>;
+
+            struct Score
+            {
+                std::string login;
+                uint32_t experience = 0;
+            };
+
+            uint32_t serverID = 0;
+            uint64_t frame = 0;
+            uint32_t playersCount = 0;
+
+            uint64_t version = 0;    // changes with any score
+            uint64_t topVersion = 0; // changes with the top only
+
+            // leaderboard top, best first; top and topJson are shared by summaries with the same topVersion
+            std::shared_ptr<const std::vector<Score>> top;
+
+            // Top() serialized as [{"name", "exp"}, ...]
+            std::shared_ptr<const std::string> topJson;
+
+            // every alive player by login; shared by summaries with the same version
+            std::shared_ptr<const std::unordered_map<std::string, uint32_t>> scores;
+
+            [[nodiscard]] std::span<const Score> Top() const
+            {
+                return top ? std::span<const Score>(*top) : std::span<const Score>{};
+            }
+
+            [[nodiscard]] std::optional<uint32_t> ScoreOf(const std::string & login) const
+            {
+                if (!scores)
+                    return std::nullopt;
+
+                const auto it = scores->find(login);
+                if (it == scores->end())
+                    return std::nullopt;
+
+                return it->second;
+            }
+        };
+
         class GameServer: public BaseServiceContainer
         {
         public:
@@ -27,9 +78,11 @@ namespace Core::App::Game
 
             [[nodiscard]] virtual uint32_t GetPlayersCount() const = 0;
 
+            // any thread, applied at the start of the next arena tick
             virtual void SetSSIDPlayer(uint64_t ssid, const Player::Shared & player) = 0;
 
-            virtual std::unordered_map<Player::Shared, uint32_t> GetLeaderboard() = 0;
+            // latest published summary, never null
+            [[nodiscard]] virtual ArenaSummary::Shared GetSummary() const = 0;
 
             // virtual Snake::Shared GetPlayerSnake() = 0;
             //
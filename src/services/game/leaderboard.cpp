@@ -0,0 +1,89 @@
+#include "leaderboard.hpp"
+
+#include <algorithm>
+
+namespace Core::App::Game
+{
+    bool Leaderboard::InTop(const Key & key) const
+    {
+        std::size_t rank = 0;
+        for (auto it = order_.begin(); it != order_.end() && rank < topSize_; ++it, ++rank)
+        {
+            if (*it == key)
+                return true;
+        }
+
+        return false;
+    }
+
+    void Leaderboard::Reorder(const std::uint32_t entityID, const std::uint32_t from, const std::uint32_t to)
+    {
+        const Key before { from, entityID };
+        const Key after { to, entityID };
+
+        const bool wasTop = InTop(before);
+        order_.erase(before);
+        order_.insert(after);
+
+        if (wasTop || InTop(after))
+            topVersion_++;
+    }
+
+    void Leaderboard::SetTopSize(const std::size_t topSize)
+    {
+        topSize_ = std::max<std::size_t>(topSize, 1);
+        topVersion_++;
+    }
+
+    void Leaderboard::Set(const std::uint32_t entityID, const std::string & login, const std::uint32_t experience)
+    {
+        const auto [it, inserted] = entries_.try_emplace(entityID, Entry{ login, experience });
+        if (inserted)
+        {
+            const Key key { experience, entityID };
+            order_.insert(key);
+            version_++;
+
+            if (InTop(key))
+                topVersion_++;
+            return;
+        }
+
+        if (it->second.login != login)
+        {
+            it->second.login = login;
+            version_++;
+
+            if (InTop({ it->second.experience, entityID }))
+                topVersion_++;
+        }
+
+        Update(entityID, experience);
+    }
+
+    void Leaderboard::Update(const std::uint32_t entityID, const std::uint32_t experience)
+    {
+        const auto it = entries_.find(entityID);
+        if (it == entries_.end() || it->second.experience == experience)
+            return;
+
+        Reorder(entityID, it->second.experience, experience);
+        it->second.experience = experience;
+        version_++;
+    }
+
+    void Leaderboard::Remove(const std::uint32_t entityID)
+    {
+        const auto it = entries_.find(entityID);
+        if (it == entries_.end())
+            return;
+
+        const Key key { it->second.experience, entityID };
+        if (InTop(key))
+            topVersion_++;
+
+        order_.erase(key);
+        entries_.erase(it);
+        version_++;
+    }
+}
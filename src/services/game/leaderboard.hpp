@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace Core::App::Game
+{
+    // Players of one arena ordered by experience. Touched only when a score actually changes,
+    // so the top K is always available without a per-request rebuild or sort.
+    class Leaderboard
+    {
+    public:
+        struct Entry
+        {
+            std::string login;
+            std::uint32_t experience { 0 };
+        };
+
+    private:
+        using Key = std::pair<std::uint32_t, std::uint32_t>; // experience, EntityID
+
+        std::set<Key, std::greater<>> order_;
+        std::unordered_map<std::uint32_t, Entry> entries_; // EntityID -> entry
+
+        std::size_t topSize_ { 10 };
+
+        std::uint64_t version_ { 0 };    // any change
+        std::uint64_t topVersion_ { 0 }; // change that moved, entered or left the top K
+
+        [[nodiscard]] bool InTop(const Key & key) const;
+
+        void Reorder(std::uint32_t entityID, std::uint32_t from, std::uint32_t to);
+
+    public:
+        Leaderboard() = default;
+
+        void SetTopSize(std::size_t topSize);
+
+        // adds the snake or refreshes it
+        void Set(std::uint32_t entityID, const std::string & login, std::uint32_t experience);
+
+        // no-op for untracked snakes or an unchanged score
+        void Update(std::uint32_t entityID, std::uint32_t experience);
+
+        void Remove(std::uint32_t entityID);
+
+        // every entry, in no particular order
+        template<typename Callback>
+        void ForEach(Callback && callback) const
+        {
+            for (const auto & [entityID, entry] : entries_)
+                callback(entry);
+        }
+
+        // the first TopSize() entries, best first
+        template<typename Callback>
+        void ForEachTop(Callback && callback) const
+        {
+            std::size_t n = 0;
+            for (auto it = order_.begin(); it != order_.end() && n < topSize_; ++it, ++n)
+                callback(entries_.at(it->second));
+        }
+
+        [[nodiscard]] std::size_t Size() const
+        {
+            return order_.size();
+        }
+
+        [[nodiscard]] std::size_t TopSize() const
+        {
+            return topSize_;
+        }
+
+        [[nodiscard]] std::uint64_t Version() const
+        {
+            return version_;
+        }
+
+        [[nodiscard]] std::uint64_t TopVersion() const
+        {
+            return topVersion_;
+        }
+    };
+}
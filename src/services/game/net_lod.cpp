@@ -0,0 +1,74 @@
+#include "net_lod.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+
+#include "utils.hpp"
+
+namespace Core::App::Game
+{
+    NetLodConfig NetLodConfig::Parse(const std::string_view text)
+    {
+        NetLodConfig config;
+        config.tiers.clear();
+
+        std::size_t pos = 0;
+        while (pos < text.size())
+        {
+            auto end = text.find(',', pos);
+            if (end == std::string_view::npos)
+                end = text.size();
+
+            const auto item = text.substr(pos, end - pos);
+            pos = end + 1;
+
+            const auto colon = item.find(':');
+            if (colon == std::string_view::npos)
+                continue;
+
+            NetLodTier tier{};
+            const auto factor = item.substr(0, colon);
+            const auto interval = item.substr(colon + 1);
+
+            if (std::from_chars(factor.data(), factor.data() + factor.size(), tier.distanceFactor).ec != std::errc{})
+                continue;
+            if (std::from_chars(interval.data(), interval.data() + interval.size(), tier.interval).ec != std::errc{})
+                continue;
+
+            tier.interval = std::max<std::uint32_t>(tier.interval, 1);
+            config.tiers.push_back(tier);
+        }
+
+        if (config.tiers.empty())
+            return NetLodConfig{};
+
+        std::ranges::sort(config.tiers, {}, &NetLodTier::distanceFactor);
+        return config;
+    }
+
+    NetLodConfig NetLodConfig::FromEnv()
+    {
+        const std::string tiers = Utils::Env("GAME_NET_LOD_TIERS");
+
+        auto config = tiers.empty() ? NetLodConfig{} : Parse(tiers);
+
+        config.geometry.enabled = Utils::EnvInt("GAME_NET_LOD_GEOMETRY", 1) != 0;
+        config.geometry.maxPoints = static_cast<std::uint16_t>(
+            std::clamp(static_cast<int>(Utils::EnvInt("GAME_NET_LOD_MAX_POINTS", config.geometry.maxPoints)), 2, 0xFFFF));
+
+        config.deadReckoning.enabled = Utils::EnvInt("GAME_NET_DEAD_RECKONING", 1) != 0;
+        config.deadReckoning.maxSuppressed = static_cast<std::uint32_t>(
+            std::max(0, Utils::EnvInt("GAME_NET_DEAD_RECKONING_MAX_SUPPRESSED", static_cast<int>(config.deadReckoning.maxSuppressed))));
+
+        // fractional thresholds are allowed, e.g. "2.5"
+        if (const std::string threshold = Utils::Env("GAME_NET_DEAD_RECKONING_THRESHOLD"); !threshold.empty())
+        {
+            float value = 0.0f;
+            if (std::from_chars(threshold.data(), threshold.data() + threshold.size(), value).ec == std::errc{} && value >= 0.0f)
+                config.deadReckoning.threshold = value;
+        }
+
+        return config;
+    }
+}
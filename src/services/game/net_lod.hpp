@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Core::App::Game
+{
+    struct NetLodTier
+    {
+        float distanceFactor { 1.0f }; // upper bound, fraction of the send radius
+        std::uint32_t interval { 1 };  // evaluate the entity every N network ticks
+    };
+
+    // polyline simplification of snake bodies sent as validation samples
+    struct SnakeGeometryLod
+    {
+        bool enabled { true };
+        float screenTolerance { 2.0f };  // max deviation in world units at zoom 1, near the viewer
+        float peripheryScale { 4.0f };   // tolerance multiplier at the edge of the send radius
+        std::uint16_t maxPoints { 64 };  // per snake per packet
+
+        // world-space tolerance: screen error scales with zoom, relaxed towards the periphery
+        [[nodiscard]] float ToleranceFor(const float distance, const float sendRadius, const float zoom) const
+        {
+            const float t = sendRadius > 0.0f ? distance / sendRadius : 1.0f;
+            const float scale = 1.0f + (peripheryScale - 1.0f) * std::clamp(t, 0.0f, 1.0f);
+            return screenTolerance * zoom * scale;
+        }
+    };
+
+    // server-side mirror of the client head extrapolation (constant velocity from the last sent heads);
+    // the tail has to follow the same velocity too, otherwise the body bent and its samples are stale
+    struct DeadReckoningConfig
+    {
+        bool enabled { true };
+        float threshold { 4.0f };          // max predicted head error in world units
+        std::uint32_t maxSuppressed { 16 }; // force an update after this many network ticks, head and tail predicted or not
+    };
+
+    struct NetLodConfig
+    {
+        std::vector<NetLodTier> tiers {
+            { 0.50f, 1 },
+            { 0.80f, 2 },
+            { 1.00f, 4 },
+        };
+
+        SnakeGeometryLod geometry;
+
+        DeadReckoningConfig deadReckoning;
+
+        // "factor:interval,..." e.g. "0.5:1,0.8:2,1:4"; tiers must be sorted by factor
+        static NetLodConfig Parse(std::string_view text);
+
+        static NetLodConfig FromEnv();
+
+        [[nodiscard]] std::size_t TierFor(float distance, float sendRadius) const
+        {
+            for (std::size_t i = 0; i < tiers.size(); ++i)
+            {
+                if (distance <= tiers[i].distanceFactor * sendRadius)
+                    return i;
+            }
+
+            return tiers.size() - 1;
+        }
+
+        [[nodiscard]] std::uint32_t IntervalFor(const std::size_t tier) const
+        {
+            return tiers[tier].interval;
+        }
+    };
+}
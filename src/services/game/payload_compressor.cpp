@@ -0,0 +1,124 @@
+#include "payload_compressor.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+
+#ifdef SNAKE_SERVER_ZSTD
+#include <zstd.h>
+#endif
+
+#include "utils.hpp"
+
+namespace Core::App::Game
+{
+    CompressionConfig CompressionConfig::FromEnv()
+    {
+        CompressionConfig config;
+        config.enabled          = Utils::EnvInt("GAME_COMPRESSION", 0) != 0;
+        config.thresholdBytes   = Utils::EnvInt("GAME_COMPRESSION_THRESHOLD", 1024);
+        config.level            = Utils::EnvInt("GAME_COMPRESSION_LEVEL", 3);
+        config.dictionaryPath   = Utils::Env("GAME_COMPRESSION_DICT");
+        config.captureDirectory = Utils::Env("GAME_COMPRESSION_CAPTURE_DIR");
+        config.captureLimit     = Utils::EnvInt("GAME_COMPRESSION_CAPTURE_LIMIT", 2000);
+        return config;
+    }
+
+    PayloadCompressor::~PayloadCompressor()
+    {
+#ifdef SNAKE_SERVER_ZSTD
+        ZSTD_freeCDict(cdict_);
+        ZSTD_freeCCtx(cctx_);
+#endif
+    }
+
+    std::string PayloadCompressor::Initialise(const CompressionConfig & config)
+    {
+        config_ = config;
+
+        if (!config_.enabled)
+            return {};
+
+#ifdef SNAKE_SERVER_ZSTD
+        cctx_ = ZSTD_createCCtx();
+        if (!cctx_)
+            return "ZSTD_createCCtx failed";
+
+        if (config_.dictionaryPath.empty())
+            return {};
+
+        std::ifstream file(config_.dictionaryPath, std::ios::binary);
+        if (!file)
+            return std::format("cant open dictionary '{}'", config_.dictionaryPath);
+
+        const std::vector<char> dictionary{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+        cdict_ = ZSTD_createCDict(dictionary.data(), dictionary.size(), config_.level);
+        if (!cdict_)
+            return std::format("invalid dictionary '{}'", config_.dictionaryPath);
+
+        dictionaryID_ = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+        return {};
+#else
+        return "built without zstd";
+#endif
+    }
+
+    bool PayloadCompressor::Compress(const std::span<const std::uint8_t> payload, std::vector<std::uint8_t> & out)
+    {
+#ifdef SNAKE_SERVER_ZSTD
+        if (!cctx_ || payload.size() < config_.thresholdBytes)
+        {
+            stats_.skipped++;
+            return false;
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+
+        constexpr std::size_t headerSize = sizeof(CompressedPayloadHeader);
+        out.resize(headerSize + ZSTD_compressBound(payload.size()));
+
+        const std::size_t written = cdict_
+            ? ZSTD_compress_usingCDict(cctx_, out.data() + headerSize, out.size() - headerSize,
+                                       payload.data(), payload.size(), cdict_)
+            : ZSTD_compressCCtx(cctx_, out.data() + headerSize, out.size() - headerSize,
+                                payload.data(), payload.size(), config_.level);
+
+        // time spent on payloads sent raw is not part of the per-message encode cost
+        if (ZSTD_isError(written) || headerSize + written >= payload.size())
+        {
+            stats_.skipped++;
+            return false;
+        }
+
+        stats_.encodeTime += std::chrono::steady_clock::now() - started;
+
+        CompressedPayloadHeader header{};
+        header.dictionaryID = dictionaryID_;
+        header.rawBytes = static_cast<std::uint32_t>(payload.size());
+        std::memcpy(out.data(), &header, headerSize);
+        out.resize(headerSize + written);
+
+        stats_.messages++;
+        stats_.rawBytes += payload.size();
+        stats_.compressedBytes += out.size();
+        return true;
+#else
+        stats_.skipped++;
+        return false;
+#endif
+    }
+
+    void PayloadCompressor::Capture(const std::string_view kind, const std::span<const std::uint8_t> payload)
+    {
+        if (config_.captureDirectory.empty() || captured_ >= config_.captureLimit)
+            return;
+
+        const auto path = std::filesystem::path(config_.captureDirectory) / std::format("{}_{:06}.bin", kind, captured_++);
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    }
+}
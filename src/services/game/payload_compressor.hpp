@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+
+namespace Core::App::Game
+{
+    // prepended to a compressed payload; the message is sent as CompressedType(type)
+    #pragma pack(push, 1)
+    struct CompressedPayloadHeader
+    {
+        std::uint32_t dictionaryID { 0 }; // 0 = no dictionary
+        std::uint32_t rawBytes { 0 };
+    };
+    #pragma pack(pop)
+
+    struct CompressionConfig
+    {
+        bool enabled { false };
+        std::size_t thresholdBytes { 1024 };
+        int level { 3 };
+        std::string dictionaryPath;     // zstd dictionary trained offline (`zstd --train`)
+        std::string captureDirectory;   // dump raw payloads here to build the training set
+        std::uint32_t captureLimit { 2000 };
+
+        static CompressionConfig FromEnv();
+    };
+
+    struct CompressionStats
+    {
+        std::uint64_t messages { 0 };
+        std::uint64_t skipped { 0 };   // below threshold or not worth it
+        std::uint64_t rawBytes { 0 };
+        std::uint64_t compressedBytes { 0 };
+        std::chrono::nanoseconds encodeTime { 0 }; // compressed messages only
+
+        [[nodiscard]] double Ratio() const
+        {
+            return compressedBytes ? static_cast<double>(rawBytes) / static_cast<double>(compressedBytes) : 0.0;
+        }
+
+        [[nodiscard]] double EncodeMicrosPerMessage() const
+        {
+            return messages ? static_cast<double>(encodeTime.count()) / 1000.0 / static_cast<double>(messages) : 0.0;
+        }
+    };
+
+    class PayloadCompressor
+    {
+        CompressionConfig config_;
+        CompressionStats stats_;
+
+        std::uint32_t dictionaryID_ { 0 };
+        std::uint32_t captured_ { 0 };
+
+        ZSTD_CCtx_s* cctx_ { nullptr };
+        ZSTD_CDict_s* cdict_ { nullptr };
+
+    public:
+        PayloadCompressor() = default;
+        ~PayloadCompressor();
+
+        PayloadCompressor(const PayloadCompressor &) = delete;
+        PayloadCompressor & operator=(const PayloadCompressor &) = delete;
+
+        // returns an error description, empty on success
+        std::string Initialise(const CompressionConfig & config);
+
+        [[nodiscard]] bool IsAvailable() const
+        {
+            return cctx_ != nullptr;
+        }
+
+        [[nodiscard]] std::uint32_t DictionaryID() const
+        {
+            return dictionaryID_;
+        }
+
+        [[nodiscard]] const CompressionStats & Stats() const
+        {
+            return stats_;
+        }
+
+        // writes CompressedPayloadHeader + zstd frame into `out`;
+        // false means the raw payload should be sent instead
+        bool Compress(std::span<const std::uint8_t> payload, std::vector<std::uint8_t> & out);
+
+        // stores a raw payload sample for offline dictionary training
+        void Capture(std::string_view kind, std::span<const std::uint8_t> payload);
+    };
+}
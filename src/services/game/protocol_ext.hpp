@@ -0,0 +1,36 @@
+#pragma once
+
+#include "game_messages.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Protocol additions negotiated on top of the shared legacy game protocol.
+// They belong in game_messages.hpp next to RequestFullUpdateFlag_AllSegments;
+// keep this file in sync with the client until snake-shared carries them.
+namespace Core::App::Game
+{
+    // RequestFullUpdate flag: the client can inflate compressed FullUpdate / SnakeSnapshot payloads;
+    // RequestFullUpdateCompression follows RequestFullUpdatePayload when it is set
+    constexpr std::uint32_t RequestFullUpdateFlag_Compression = 1u << 1;
+
+    #pragma pack(push, 1)
+    struct RequestFullUpdateCompression
+    {
+        std::uint32_t dictionaryID { 0 }; // the zstd dictionary the client holds, 0 = none
+    };
+    #pragma pack(pop)
+
+    // RequestFullUpdate flag: the client decodes compact entity lists (see CompactEntityWriter)
+    constexpr std::uint32_t RequestFullUpdateFlag_CompactEntities = 1u << 2;
+
+    // set on MessageHeader::type when the payload is a CompressedPayloadHeader + zstd frame;
+    // the remaining bits carry the original message type
+    constexpr std::underlying_type_t<Utils::Legacy::Game::Net::MessageType> MessageTypeFlag_Compressed = 0x80;
+
+    constexpr Utils::Legacy::Game::Net::MessageType CompressedType(const Utils::Legacy::Game::Net::MessageType type)
+    {
+        return static_cast<Utils::Legacy::Game::Net::MessageType>(std::to_underlying(type) | MessageTypeFlag_Compressed);
+    }
+}
@@ -0,0 +1,80 @@
+#include "stage_worker.hpp"
+
+#include <utility>
+
+namespace Core::App::Game
+{
+    StageWorker::~StageWorker()
+    {
+        if (!thread_.joinable())
+            return;
+
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void StageWorker::Start(const bool threaded)
+    {
+        if (threaded && !thread_.joinable())
+            thread_ = std::thread(&StageWorker::Loop, this);
+    }
+
+    void StageWorker::Run(std::function<void()> job)
+    {
+        if (!thread_.joinable())
+        {
+            job();
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            job_ = std::move(job);
+            busy_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    void StageWorker::Wait()
+    {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [this] { return !busy_; });
+
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+    void StageWorker::Loop()
+    {
+        std::unique_lock lock(mutex_);
+
+        while (true)
+        {
+            cv_.wait(lock, [this] { return busy_ || stop_; });
+            if (stop_ && !busy_)
+                return;
+
+            auto job = std::move(job_);
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                job();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            error_ = error;
+            busy_ = false;
+            cv_.notify_all();
+        }
+    }
+}
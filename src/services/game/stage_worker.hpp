@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Core::App::Game
+{
+    // Runs one job at a time on a dedicated thread. Wait() is the hand-off point between two pipeline stages:
+    // once it returns, everything the job touched is visible to the caller again.
+    class StageWorker
+    {
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+
+        std::function<void()> job_;
+        std::exception_ptr error_;
+        bool busy_ { false };
+        bool stop_ { false };
+
+        void Loop();
+
+    public:
+        StageWorker() = default;
+        StageWorker(const StageWorker &) = delete;
+        StageWorker & operator=(const StageWorker &) = delete;
+
+        ~StageWorker();
+
+        // threaded = false runs every job inline in Run()
+        void Start(bool threaded);
+
+        [[nodiscard]] bool IsThreaded() const
+        {
+            return thread_.joinable();
+        }
+
+        // the previous job must have been waited for
+        void Run(std::function<void()> job);
+
+        // blocks until the current job is done, rethrows what it threw
+        void Wait();
+    };
+}
@@ -0,0 +1,46 @@
+#include "world_snapshot.hpp"
+
+namespace Core::App::Game
+{
+    void WorldSnapshot::Clear()
+    {
+        frame = 0;
+        snakes.clear();
+        segments.clear();
+        viewers.clear();
+        index_.clear();
+    }
+
+    void WorldSnapshot::AddSnake(const Utils::Legacy::Game::Entity::Snake::Shared & snake)
+    {
+        SnakeView view{};
+        view.entityID = snake->EntityID();
+        view.head = snake->GetPosition();
+        view.experience = snake->GetExperience();
+        view.zoom = snake->GetZoom();
+        view.radius = snake->GetRadius(false);
+        view.killed = snake->IsKilled();
+        view.segmentsOffset = static_cast<std::uint32_t>(segments.size());
+
+        // killed snakes are never sent, only their head / zoom matter as a viewer
+        if (!view.killed)
+        {
+            const auto & body = snake->Segments();
+            segments.insert(segments.end(), body.begin(), body.end());
+        }
+
+        view.segmentsCount = static_cast<std::uint32_t>(segments.size()) - view.segmentsOffset;
+
+        index_[view.entityID] = static_cast<std::uint32_t>(snakes.size());
+        snakes.push_back(view);
+    }
+
+    std::optional<std::uint32_t> WorldSnapshot::IndexOf(const std::uint32_t entityID) const
+    {
+        const auto it = index_.find(entityID);
+        if (it == index_.end())
+            return std::nullopt;
+
+        return it->second;
+    }
+}
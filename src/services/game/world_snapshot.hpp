@@ -0,0 +1,67 @@
+#pragma once
+
+#include "food_chunks.hpp"
+
+#include "legacy_entities.hpp"
+#include "udp.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Core::App::Game
+{
+    // what the network stage needs from a snake entity
+    struct SnakeView
+    {
+        std::uint32_t entityID { 0 };
+        sf::Vector2f head {};
+        std::uint32_t experience { 0 };
+        float zoom { 1.0f };
+        float radius { 0.0f }; // body radius, GetRadius(false)
+        bool killed { false };
+
+        std::uint32_t segmentsOffset { 0 }; // into WorldSnapshot::segments, empty for killed snakes
+        std::uint32_t segmentsCount { 0 };
+    };
+
+    // Read-only copy of one simulation tick, serialized by the network stage while the next tick is simulated.
+    // GameServer double-buffers two of these; Clear() keeps every buffer, so after warm-up publishing is
+    // one copy of the snake bodies into `segments` plus a pointer copy per food chunk.
+    struct WorldSnapshot
+    {
+        struct Viewer
+        {
+            Utils::Net::Udp::Session::Shared session;
+            std::uint32_t snake { 0 }; // index into snakes
+            bool fullUpdate { false };
+        };
+
+        std::uint64_t frame { 0 };
+
+        std::vector<SnakeView> snakes;
+        std::vector<sf::Vector2f> segments; // every snake body, back to back
+
+        FoodChunks foods;
+
+        std::vector<Viewer> viewers;
+
+        void Clear();
+
+        void AddSnake(const Utils::Legacy::Game::Entity::Snake::Shared & snake);
+
+        [[nodiscard]] std::optional<std::uint32_t> IndexOf(std::uint32_t entityID) const;
+
+        [[nodiscard]] std::span<const sf::Vector2f> Segments(const SnakeView & snake) const
+        {
+            return std::span(segments).subspan(snake.segmentsOffset, snake.segmentsCount);
+        }
+
+    private:
+        std::unordered_map<std::uint32_t, std::uint32_t> index_; // EntityID -> snakes index
+    };
+}
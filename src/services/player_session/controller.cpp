@@ -5,12 +5,90 @@ namespace Core::App::PlayerSession
 {
     void Controller::Initialise()
     {
-        Log()->Debug("Initialised");
+        profiles_.Configure(Model::ProfileCacheConfig::FromEnv());
+
+        experienceWrites_.Configure(Model::ExperienceWriterConfig::FromEnv());
+
+        Log()->Debug("Initialised, profile cache {} entries / {}s, experience flushed every {}ms",
+                     profiles_.Config().capacity, profiles_.Config().ttl.count(),
+                     experienceWrites_.Config().interval.count());
+    }
+
+    void Controller::OnAllServicesLoaded()
+    {
+        IFace().Register<Interface::Controller>(shared_from_this());
+    }
+
+    void Controller::ProcessTick()
+    {
+        experienceWrites_.Flush(connector_, std::chrono::steady_clock::now(), false);
+
+        LogStats();
+    }
+
+    void Controller::LogStats()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration<double>(now - statsSince_).count();
+        if (elapsed < 60.0)
+            return;
+
+        LogProfileCacheStats();
+        LogExperienceWriterStats(elapsed);
+
+        statsSince_ = now;
+    }
+
+    void Controller::LogProfileCacheStats()
+    {
+        auto & stats = profiles_.Stats();
+        const uint64_t hits = stats.hits;
+        const uint64_t misses = stats.misses;
+        if (hits || misses)
+        {
+            Log()->Debug("[PROFILES] hits={} misses={} ({:.1f}% hit) expired={} evictions={} size={}",
+                         hits, misses,
+                         100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses),
+                         stats.expired.load(), stats.evictions.load(),
+                         profiles_.Size());
+        }
+
+        stats.Reset();
+    }
+
+    void Controller::LogExperienceWriterStats(const double elapsed)
+    {
+        auto & stats = experienceWrites_.Stats();
+        const uint64_t reports = stats.reports;
+        const uint64_t flushes = stats.flushes;
+        const uint64_t rows = stats.rows;
+        if (reports || flushes || stats.failures)
+        {
+            Log()->Debug("[EXP] reports={} ({:.1f}/s, {} coalesced) flushes={} rows={} ({:.1f}/flush, max {}) failures={} delay={:.0f}ms/row (max {:.0f}ms) query={:.1f}ms/flush waiting={}",
+                         reports, static_cast<double>(reports) / elapsed, stats.coalesced.load(),
+                         flushes, rows,
+                         flushes ? static_cast<double>(rows) / static_cast<double>(flushes) : 0.0, stats.maxRows.load(),
+                         stats.failures.load(),
+                         rows ? static_cast<double>(stats.delayNs) / 1e6 / static_cast<double>(rows) : 0.0,
+                         static_cast<double>(stats.maxDelayNs) / 1e6,
+                         flushes ? static_cast<double>(stats.queryNs) / 1e6 / static_cast<double>(flushes) : 0.0,
+                         experienceWrites_.Size());
+        }
+
+        stats.Reset();
     }
 
     void Controller::OnAllInterfacesLoaded()
     {
         server_ = IFace().Get<Server>();
+        connector_ = IFace().Get<Components::MySQL::Interface::Connector>();
+
+        // the main loop keeps ticking (and the connector answering) until this returns true
+        GetShutdownHooks().Add("player experience", [this]
+        {
+            experienceWrites_.Flush(connector_, std::chrono::steady_clock::now(), true);
+            return experienceWrites_.Idle();
+        });
 
         server_->RegisterClientsCallback([this](const Client::Shared & client, const Client::Events & event) {
             if (event == Client::Events::ClientConnected)
@@ -27,6 +105,7 @@ namespace Core::App::PlayerSession
 
     Interface::Player::Shared Controller::GetPlayer(const Servers::Websocket::Interface::Client::Shared & client)
     {
+        std::lock_guard lock(playersMutex_);
         const auto it = players_.find(client);
         if (it == players_.end())
         {
@@ -40,21 +119,28 @@ namespace Core::App::PlayerSession
     void Controller::OnClientConnected(const Client::Shared & client)
     {
         auto player = Player::Create(this, client);
+
+        std::lock_guard lock(playersMutex_);
         players_[client] = player;
     }
 
     void Controller::OnClientDisconnected(const Client::Shared & client)
     {
-        const auto it = players_.find(client);
-        if (it == players_.end())
+        Player::Shared player;
         {
-            Log()->Error("OnClientDisconnected: No such player");
-            return;
-        }
+            std::lock_guard lock(playersMutex_);
+            const auto it = players_.find(client);
+            if (it == players_.end())
+            {
+                Log()->Error("OnClientDisconnected: No such player");
+                return;
+            }
 
-        it->second->Close();
+            player = std::move(it->second);
+            players_.erase(it);
+        }
 
-        players_.erase(it);
+        player->Close();
 
     }
 }
\ No newline at end of file
@@ -5,6 +5,11 @@
 
 #include "player.hpp"
 
+#include "components/mysql/interface/connector.hpp"
+
+#include <chrono>
+#include <mutex>
+
 namespace Core::App::PlayerSession
 {
     class Controller final : public Interface::Controller, public std::enable_shared_from_this<Controller>
@@ -15,18 +20,47 @@ namespace Core::App::PlayerSession
 
         Server::Shared server_ {};
 
+        // connect / disconnect / GetPlayer arrive on the strands of different clients
+        mutable std::mutex playersMutex_;
         std::unordered_map<Client::Shared, Player::Shared> players_ {};
+
+        Components::MySQL::Interface::Connector::Shared connector_ {};
+
+        Model::ProfileCache profiles_ {};
+        Model::ExperienceWriter experienceWrites_ {};
+
+        std::chrono::steady_clock::time_point statsSince_ = std::chrono::steady_clock::now();
+
+        void LogStats();
+
+        void LogProfileCacheStats();
+
+        void LogExperienceWriterStats(double elapsed);
     public:
         using Shared = std::shared_ptr<Controller>;
 
         void Initialise() override;
 
+        void OnAllServicesLoaded() override;
+
         void OnAllInterfacesLoaded() override;
 
+        void ProcessTick() override;
+
         void CreateSession(uint32_t ownerAccountID) override;
 
         Interface::Player::Shared GetPlayer(const Servers::Websocket::Interface::Client::Shared & client) override;
 
+        Model::ProfileCache & Profiles() override
+        {
+            return profiles_;
+        }
+
+        Model::ExperienceWriter & ExperienceWrites() override
+        {
+            return experienceWrites_;
+        }
+
         void OnClientConnected(const Client::Shared & client);
 
         void OnClientDisconnected(const Client::Shared & client);
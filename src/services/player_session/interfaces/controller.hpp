@@ -1,6 +1,8 @@
 #pragma once
 
 #include "player.hpp"
+#include "../models/experience_writer.hpp"
+#include "../models/profile_cache.hpp"
 #include "servers/websocket/message.hpp"
 
 namespace Core::App::PlayerSession
@@ -15,6 +17,11 @@ namespace Core::App::PlayerSession
             virtual void CreateSession(uint32_t ownerAccountID) = 0;
 
             virtual Player::Shared GetPlayer(const Servers::Websocket::Interface::Client::Shared & client) = 0;
+
+            // shared by every player model of the process
+            virtual Model::ProfileCache & Profiles() = 0;
+
+            virtual Model::ExperienceWriter & ExperienceWrites() = 0;
         };
     }
 }
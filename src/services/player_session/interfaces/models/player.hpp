@@ -24,6 +24,13 @@ namespace Core::App::PlayerSession::Model
 
             [[nodiscard]] virtual std::string GetLogin() const = 0;
 
+            [[nodiscard]] virtual uint32_t GetUserID() const = 0;
+
+            [[nodiscard]] virtual uint32_t GetExperience() const = 0;
+
+            // any thread (arenas); stored write-behind, see ExperienceWriter
+            virtual void SetExperience(uint32_t experience) = 0;
+
             enum SerialiseType
             {
                 SerialisePlayer,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../interfaces/models/[base].hpp"
+#include "../interfaces/controller.hpp"
 #include "components/mysql/interface/connector.hpp"
 
 namespace Core::App::PlayerSession::Model
@@ -8,17 +9,35 @@ namespace Core::App::PlayerSession::Model
     class BaseModel: public virtual BaseServiceContainer
     {
         Components::MySQL::Interface::Connector::Shared connector_;
+
+        // owned by the controller, which outlives every session
+        ProfileCache * profiles_ = nullptr;
+        ExperienceWriter * experienceWrites_ = nullptr;
     public:
         using Shared = std::shared_ptr<BaseModel>;
 
         BaseModel()
         {
             connector_ = BaseServiceContainer::IFace().Get<Components::MySQL::Interface::Connector>();
+
+            const auto controller = BaseServiceContainer::IFace().Get<PlayerSession::Interface::Controller>();
+            profiles_ = &controller->Profiles();
+            experienceWrites_ = &controller->ExperienceWrites();
         }
 
         [[nodiscard]] const Components::MySQL::Interface::Connector::Shared & Database() const
         {
             return connector_;
         }
+
+        [[nodiscard]] ProfileCache & Profiles() const
+        {
+            return *profiles_;
+        }
+
+        [[nodiscard]] ExperienceWriter & ExperienceWrites() const
+        {
+            return *experienceWrites_;
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "experience_writer.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+
+namespace Core::App::PlayerSession::Model
+{
+    namespace
+    {
+        void StoreMax(std::atomic<uint64_t> & target, const uint64_t value)
+        {
+            auto current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+        uint64_t Nanos(const ExperienceWriter::Clock::duration duration)
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+    }
+
+    ExperienceWriterConfig ExperienceWriterConfig::FromEnv()
+    {
+        ExperienceWriterConfig config;
+
+        config.interval = std::chrono::milliseconds{ std::max(0, Utils::EnvInt("PLAYER_EXP_FLUSH_MS", static_cast<int>(config.interval.count()))) };
+        config.maxRows = static_cast<std::size_t>(std::max(1, Utils::EnvInt("PLAYER_EXP_FLUSH_ROWS", static_cast<int>(config.maxRows))));
+
+        return config;
+    }
+
+    void ExperienceWriter::Report(const uint32_t userID, const uint32_t experience)
+    {
+        const auto now = Clock::now();
+
+        std::lock_guard lock(mutex_);
+        stats_.reports.fetch_add(1, std::memory_order_relaxed);
+
+        // a replaced value keeps its age, so a busy player is still written every interval
+        if (const auto [it, inserted] = pending_.try_emplace(userID, Pending{ experience, now }); !inserted)
+        {
+            it->second.experience = experience;
+            stats_.coalesced.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        oldest_ = std::min(oldest_, now);
+    }
+
+    std::optional<uint32_t> ExperienceWriter::Find(const uint32_t userID)
+    {
+        std::lock_guard lock(mutex_);
+
+        if (const auto it = pending_.find(userID); it != pending_.end())
+            return it->second.experience;
+
+        // the UPDATE may still be on its way, the database would answer the old value
+        if (const auto it = sent_.find(userID); it != sent_.end())
+            return it->second.experience;
+
+        return std::nullopt;
+    }
+
+    void ExperienceWriter::Flush(const Components::MySQL::Interface::Connector::Shared & connector, const Clock::time_point now, const bool force)
+    {
+        std::vector<std::pair<uint64_t, std::vector<Row>>> statements;
+        {
+            std::lock_guard lock(mutex_);
+            if (pending_.empty() || (!force && now - oldest_ < config_.interval))
+                return;
+
+            // every waiting row goes out, oldest_ only tracks when the next flush is due
+            statements.emplace_back(++statements_, std::vector<Row>{});
+            for (const auto & [userID, pending] : pending_)
+            {
+                if (statements.back().second.size() == config_.maxRows)
+                    statements.emplace_back(++statements_, std::vector<Row>{});
+
+                statements.back().second.push_back(Row{ userID, pending.experience, pending.since });
+                sent_[userID] = Sent{ pending.experience, statements.back().first };
+            }
+
+            pending_.clear();
+            oldest_ = Clock::time_point::max();
+        }
+
+        for (auto & [statement, rows] : statements)
+        {
+            // update `snake_players` set `experience` = case `id` when 1 then 10 ... end where `id` in (1, ...)
+            std::string sql = "update `snake_players` set `experience` = case `id`";
+            std::string ids;
+            for (const auto & row : rows)
+            {
+                sql += " when " + std::to_string(row.userID) + " then " + std::to_string(row.experience);
+
+                if (!ids.empty())
+                    ids += ", ";
+                ids += std::to_string(row.userID);
+
+                const auto delay = Nanos(now - row.since);
+                stats_.delayNs.fetch_add(delay, std::memory_order_relaxed);
+                StoreMax(stats_.maxDelayNs, delay);
+            }
+            sql += " end where `id` in (" + ids + ")";
+
+            stats_.flushes.fetch_add(1, std::memory_order_relaxed);
+            stats_.rows.fetch_add(rows.size(), std::memory_order_relaxed);
+            StoreMax(stats_.maxRows, rows.size());
+
+            inFlight_.fetch_add(1, std::memory_order_relaxed);
+
+            connector->Query(sql) = [this, statement, rows = std::move(rows), sent = Clock::now()](const Components::MySQL::Interface::RequestResult::Shared & result)
+            {
+                stats_.queryNs.fetch_add(Nanos(Clock::now() - sent), std::memory_order_relaxed);
+
+                const bool success = result && result->IsSuccess();
+                if (!success)
+                    stats_.failures.fetch_add(1, std::memory_order_relaxed);
+
+                Complete(statement, rows, success);
+
+                inFlight_.fetch_sub(1, std::memory_order_release);
+            };
+        }
+    }
+
+    void ExperienceWriter::Complete(const uint64_t statement, const std::vector<Row> & rows, const bool success)
+    {
+        const auto now = Clock::now();
+
+        std::lock_guard lock(mutex_);
+
+        for (const auto & row : rows)
+        {
+            // a later statement carries a newer value, this one neither clears nor retries it
+            const auto it = sent_.find(row.userID);
+            if (it == sent_.end() || it->second.statement != statement)
+                continue;
+
+            sent_.erase(it);
+
+            // retried one interval later, not on the next tick while the database is down;
+            // a newer report already waiting wins
+            if (!success && pending_.try_emplace(row.userID, Pending{ row.experience, row.since }).second)
+                oldest_ = std::min(oldest_, now);
+        }
+    }
+
+    bool ExperienceWriter::Idle()
+    {
+        if (inFlight_.load(std::memory_order_acquire) != 0)
+            return false;
+
+        std::lock_guard lock(mutex_);
+        return pending_.empty();
+    }
+
+    std::size_t ExperienceWriter::Size()
+    {
+        std::lock_guard lock(mutex_);
+        return pending_.size();
+    }
+}
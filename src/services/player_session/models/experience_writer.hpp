@@ -0,0 +1,123 @@
+#pragma once
+
+#include "components/mysql/interface/connector.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Core::App::PlayerSession::Model
+{
+    struct ExperienceWriterConfig
+    {
+        std::chrono::milliseconds interval { 5000 }; // how long a value may wait in memory
+        std::size_t maxRows = 500;                   // per statement
+
+        // PLAYER_EXP_FLUSH_MS, PLAYER_EXP_FLUSH_ROWS
+        static ExperienceWriterConfig FromEnv();
+    };
+
+    struct ExperienceWriterStats
+    {
+        std::atomic<uint64_t> reports = 0;
+        std::atomic<uint64_t> coalesced = 0; // reports that replaced a value still waiting
+        std::atomic<uint64_t> flushes = 0;
+        std::atomic<uint64_t> rows = 0;
+        std::atomic<uint64_t> maxRows = 0;
+        std::atomic<uint64_t> failures = 0;   // statements, their rows are retried
+        std::atomic<uint64_t> delayNs = 0;    // first report -> statement sent, summed over rows
+        std::atomic<uint64_t> maxDelayNs = 0;
+        std::atomic<uint64_t> queryNs = 0;    // statement sent -> result, summed over flushes
+
+        void Reset()
+        {
+            reports = 0;
+            coalesced = 0;
+            flushes = 0;
+            rows = 0;
+            maxRows = 0;
+            failures = 0;
+            delayNs = 0;
+            maxDelayNs = 0;
+            queryNs = 0;
+        }
+    };
+
+    /*
+        Write-behind of player experience: only the latest value per player is kept in memory, and
+        flushed as one multi-row UPDATE once the oldest waiting value is `interval` old.
+        Report() from any thread, Flush() from the main loop; failed rows go back unless a newer value arrived.
+        Sent rows stay visible to Find() until their statement is answered.
+    */
+    class ExperienceWriter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        struct Pending
+        {
+            uint32_t experience = 0;
+            Clock::time_point since;
+        };
+
+        struct Sent
+        {
+            uint32_t experience = 0;
+            uint64_t statement = 0; // the last statement carrying this player
+        };
+
+        struct Row
+        {
+            uint32_t userID = 0;
+            uint32_t experience = 0;
+            Clock::time_point since;
+        };
+
+        ExperienceWriterConfig config_;
+        ExperienceWriterStats stats_;
+
+        std::mutex mutex_;
+        std::unordered_map<uint32_t, Pending> pending_; // by user ID
+        std::unordered_map<uint32_t, Sent> sent_;       // by user ID, written but not answered yet
+        Clock::time_point oldest_ = Clock::time_point::max();
+        uint64_t statements_ = 0;
+
+        std::atomic<uint32_t> inFlight_ = 0; // statements sent, not answered yet
+
+        void Complete(uint64_t statement, const std::vector<Row> & rows, bool success);
+
+    public:
+        void Configure(const ExperienceWriterConfig & config)
+        {
+            config_ = config;
+        }
+
+        [[nodiscard]] const ExperienceWriterConfig & Config() const
+        {
+            return config_;
+        }
+
+        [[nodiscard]] ExperienceWriterStats & Stats()
+        {
+            return stats_;
+        }
+
+        void Report(uint32_t userID, uint32_t experience);
+
+        // a value not written yet, newer than what the database holds
+        [[nodiscard]] std::optional<uint32_t> Find(uint32_t userID);
+
+        // sends due rows, or every row when force is set (shutdown)
+        void Flush(const Components::MySQL::Interface::Connector::Shared & connector, Clock::time_point now, bool force);
+
+        // nothing waiting and nothing in flight
+        [[nodiscard]] bool Idle();
+
+        [[nodiscard]] std::size_t Size();
+    };
+}
@@ -15,6 +15,7 @@ namespace Core::App::PlayerSession::Model
         login_ = login;
         hashedPassword_ = Utils::Crypt::GetSHA256(password);
 
+        // not batched: the login column compares by its collation, which rows can't be matched back to
         const auto found = co_await Database()->Query("select id from `snake_players` where login = {}", login_);
 
         if (!found->IsSuccess() || found->Count())
@@ -32,6 +33,8 @@ namespace Core::App::PlayerSession::Model
 
         userID_ = insert->InsertID();
 
+        Profiles().Put({ userID_, login_, userExp_.load() });
+
         type_ = PlayerBase;
 
         PrepareToken();
@@ -51,8 +54,13 @@ namespace Core::App::PlayerSession::Model
             co_return false;
         }
 
-        userID_ = std::stoul(found->Get(0)["id"].as_string().c_str());
-        userExp_ = std::stoul(found->Get(0)["experience"].as_string().c_str());
+        const auto [userID, experience] = found->At(0).As<uint32_t, uint32_t>();
+        userID_ = userID;
+
+        // the database may not have the last arena result yet
+        userExp_ = ExperienceWrites().Find(userID_).value_or(experience);
+
+        Profiles().Put({ userID_, login_, userExp_.load() });
 
         type_ = PlayerBase;
 
@@ -87,14 +95,24 @@ namespace Core::App::PlayerSession::Model
             co_return false;
         }
 
-        const auto found = co_await Database()->Query("select experience from `snake_players` where id = {}", userID_);
-
-        if (!found->IsSuccess() || !found->Count())
+        // a valid token is all that is checked, the profile may come from the cache
+        if (const auto profile = Profiles().Find(userID_))
         {
-            co_return false;
+            userExp_ = profile->experience;
         }
+        else
+        {
+            const auto found = co_await Database()->Load("select id, experience from `snake_players`", "id", uint64_t{ userID_ });
+
+            if (!found.Found())
+            {
+                co_return false;
+            }
 
-        userExp_ = std::stoul(found->Get(0)["experience"].as_string().c_str());
+            userExp_ = ExperienceWrites().Find(userID_).value_or(found.Get().Get<uint32_t>("experience"));
+
+            Profiles().Put({ userID_, login_, userExp_.load() });
+        }
 
         type_ = PlayerBase;
 
@@ -108,6 +126,29 @@ namespace Core::App::PlayerSession::Model
         return login_;
     }
 
+    uint32_t Player::GetUserID() const
+    {
+        return userID_;
+    }
+
+    uint32_t Player::GetExperience() const
+    {
+        return userExp_;
+    }
+
+    void Player::SetExperience(const uint32_t experience)
+    {
+        // anonymous players have no row to write
+        if (userID_ == 0)
+            return;
+
+        userExp_ = experience;
+
+        // the cache follows at once, the row on the next flush
+        Profiles().Put({ userID_, login_, experience });
+        ExperienceWrites().Report(userID_, experience);
+    }
+
     [[nodiscard]] boost::json::object Player::Serialise(const SerialiseType & serialiseType)
     {
         boost::json::object result;
@@ -117,8 +158,8 @@ namespace Core::App::PlayerSession::Model
 
         if (serialiseType == SerialisePlayer)
         {
-            result["experience"] = userExp_;
-            result["playerType"] = PlayerTypeMap[type_];
+            result["experience"] = userExp_.load();
+            result["playerType"] = PlayerTypeMap[type_.load()];
             result["token"] = token_;
         }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <utility>
 
 #include "[base].hpp"
@@ -12,10 +13,10 @@ namespace Core::App::PlayerSession::Model
         public BaseModel,
         public std::enable_shared_from_this<Player>
     {
-        PlayerType type_ = PlayerAnonymous;
+        std::atomic<PlayerType> type_ = PlayerAnonymous; // written last by the login tasks on the main loop
 
         uint32_t userID_ = 0;
-        uint32_t userExp_ = 0;
+        std::atomic<uint32_t> userExp_ = 0; // the arena updates it from its own thread
 
         std::string login_, hashedPassword_;
         std::string token_;
@@ -34,6 +35,12 @@ namespace Core::App::PlayerSession::Model
 
         std::string GetLogin() const override;
 
+        uint32_t GetUserID() const override;
+
+        uint32_t GetExperience() const override;
+
+        void SetExperience(uint32_t experience) override;
+
 
         [[nodiscard]] boost::json::object Serialise(const SerialiseType & serialiseType = SerialisePlayer) override;
 
@@ -0,0 +1,89 @@
+#include "profile_cache.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+
+namespace Core::App::PlayerSession::Model
+{
+    ProfileCacheConfig ProfileCacheConfig::FromEnv()
+    {
+        ProfileCacheConfig config;
+
+        config.capacity = static_cast<std::size_t>(std::max(0, Utils::EnvInt("PROFILE_CACHE_SIZE", static_cast<int>(config.capacity))));
+        config.ttl = std::chrono::seconds{ std::max(1, Utils::EnvInt("PROFILE_CACHE_TTL_S", static_cast<int>(config.ttl.count()))) };
+
+        return config;
+    }
+
+    void ProfileCache::Configure(const ProfileCacheConfig & config)
+    {
+        std::lock_guard lock(mutex_);
+        config_ = config;
+
+        while (entries_.size() > config_.capacity)
+        {
+            index_.erase(entries_.back().profile.id);
+            entries_.pop_back();
+        }
+    }
+
+    std::optional<Profile> ProfileCache::Find(const uint32_t id)
+    {
+        std::lock_guard lock(mutex_);
+
+        const auto it = index_.find(id);
+        if (it == index_.end())
+        {
+            stats_.misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        if (it->second->expiresAt <= Clock::now())
+        {
+            entries_.erase(it->second);
+            index_.erase(it);
+            stats_.expired.fetch_add(1, std::memory_order_relaxed);
+            stats_.misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        entries_.splice(entries_.begin(), entries_, it->second);
+        stats_.hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second->profile;
+    }
+
+    void ProfileCache::Put(Profile profile)
+    {
+        std::lock_guard lock(mutex_);
+        if (config_.capacity == 0)
+            return;
+
+        const auto expiresAt = Clock::now() + config_.ttl;
+
+        if (const auto it = index_.find(profile.id); it != index_.end())
+        {
+            it->second->profile = std::move(profile);
+            it->second->expiresAt = expiresAt;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+
+        if (entries_.size() >= config_.capacity)
+        {
+            index_.erase(entries_.back().profile.id);
+            entries_.pop_back();
+            stats_.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const auto id = profile.id;
+        entries_.push_front(Entry{ std::move(profile), expiresAt });
+        index_[id] = entries_.begin();
+    }
+
+    std::size_t ProfileCache::Size()
+    {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace Core::App::PlayerSession::Model
+{
+    // what a token login needs from `snake_players`
+    struct Profile
+    {
+        uint32_t id = 0;
+        std::string login;
+        uint32_t experience = 0;
+    };
+
+    struct ProfileCacheConfig
+    {
+        std::size_t capacity = 10000; // 0 disables the cache
+        std::chrono::seconds ttl { 300 };
+
+        // PROFILE_CACHE_SIZE, PROFILE_CACHE_TTL_S
+        static ProfileCacheConfig FromEnv();
+    };
+
+    struct ProfileCacheStats
+    {
+        std::atomic<uint64_t> hits = 0;
+        std::atomic<uint64_t> misses = 0;
+        std::atomic<uint64_t> expired = 0; // found but past the TTL, counted as misses too
+        std::atomic<uint64_t> evictions = 0;
+
+        void Reset()
+        {
+            hits = 0;
+            misses = 0;
+            expired = 0;
+            evictions = 0;
+        }
+    };
+
+    // Bounded LRU of player profiles by user ID, entries expire after the TTL.
+    // Filled by logins and registrations, every write to a player row has to Put the new value.
+    class ProfileCache
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry
+        {
+            Profile profile;
+            Clock::time_point expiresAt;
+        };
+
+        ProfileCacheConfig config_;
+        ProfileCacheStats stats_;
+
+        std::mutex mutex_;
+        std::list<Entry> entries_; // most recently used first
+        std::unordered_map<uint32_t, std::list<Entry>::iterator> index_;
+
+    public:
+        void Configure(const ProfileCacheConfig & config);
+
+        [[nodiscard]] const ProfileCacheConfig & Config() const
+        {
+            return config_;
+        }
+
+        [[nodiscard]] ProfileCacheStats & Stats()
+        {
+            return stats_;
+        }
+
+        std::optional<Profile> Find(uint32_t id);
+
+        void Put(Profile profile);
+
+        [[nodiscard]] std::size_t Size();
+    };
+}
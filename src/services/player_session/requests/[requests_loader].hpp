@@ -47,6 +47,8 @@ namespace Core::App::PlayerSession::Requests {
         using Message = Servers::Websocket::Interface::Message;
 
         Server::Shared server_ {};
+
+        std::string responseType_; // GetType() + "::response", built once at registration
     public:
         using Shared = std::shared_ptr<RequestsServiceInstance>;
 
@@ -57,6 +59,7 @@ namespace Core::App::PlayerSession::Requests {
         void OnAllInterfacesLoaded() final
         {
             server_ = IFace().Get<Server>();
+            responseType_ = GetType() + "::response";
 
             server_->RegisterMessage(GetType(), [this](const Client::Shared & client, const Message::Shared & message) {
                 const auto player = GetController()->GetPlayer(client);
@@ -69,8 +72,8 @@ namespace Core::App::PlayerSession::Requests {
                 }
                 catch (const std::exception & e)
                 {
-                    Log()->Error("exception: {}", e.what());
-                    SendFail(player, "internal_server_error");
+                    client->Log()->Error("'{}' failed: {}", GetType(), e.what());
+                    SendFail(player, "internal_server_error", message->GetHeaders().GetSourceJobID());
                 }
             });
 
@@ -79,9 +82,29 @@ namespace Core::App::PlayerSession::Requests {
 
         virtual void OnAllInterfacesLoadedPost() {};
 
+        // Starts a model task on the main loop, where the task manager and the database live, and
+        // runs `done` with its result back on the player's strand, behind the player's other messages.
+        template<typename Result, typename Start, typename Done>
+        void AwaitOnMainLoop(const Interface::Player::Shared & player, Start start, Done done)
+        {
+            GetMainLoop().Post([player, start, done]
+            {
+                start() = [player, done](Result result)
+                {
+                    player->GetClient()->Post([done, result] { done(result); });
+                };
+            });
+        }
+
         uint64_t SendResponse(const Interface::Player::Shared & player, const boost::json::object & message, const uint64_t targetJobID = 0)
         {
-            return player->GetClient()->Send(GetType() + "::response", message, targetJobID);
+            return player->GetClient()->Send(responseType_, message, targetJobID);
+        }
+
+        // message is an already serialized JSON object
+        uint64_t SendSerializedResponse(const Interface::Player::Shared & player, const std::string_view message, const uint64_t targetJobID = 0)
+        {
+            return player->GetClient()->SendSerialized(responseType_, message, targetJobID);
         }
 
         void SendFail(const Interface::Player::Shared & player, const std::string & reason, const uint64_t targetJobID = 0)
@@ -28,7 +28,7 @@ namespace Core::App::PlayerSession::Requests {
 
     void ConnectUDP::Incoming(const Interface::Player::Shared & player, const Message::Shared & message)
     {
-        const auto sourceJobID = message->GetHeaders()->GetSourceJobID();
+        const auto sourceJobID = message->GetHeaders().GetSourceJobID();
         Log()->Debug("Incoming");
 
         const auto & model = player->Model();
@@ -34,7 +34,7 @@ namespace Core::App::PlayerSession::Requests {
 
     void LeaderBoard::Incoming(const Interface::Player::Shared & player, const Message::Shared & message)
     {
-        const auto sourceJobID = message->GetHeaders()->GetSourceJobID();
+        const auto sourceJobID = message->GetHeaders().GetSourceJobID();
         Log()->Debug("Incoming");
 
         const auto & model = player->Model();
@@ -45,26 +45,34 @@ namespace Core::App::PlayerSession::Requests {
 
         auto & request = message->GetBody();
 
-        if (!request.contains("serverId") || !request["serverId"].is_int64())
+        const auto serverIdValue = request.if_contains("serverId");
+        if (!serverIdValue || !serverIdValue->is_int64())
             return SendFail(player, "error", sourceJobID);
 
-        uint32_t serverID = request["serverId"].as_int64();
-
         const auto servers = gameController_->GetGameServers();
-        if (serverID > servers.size())
+
+        const auto requestedID = serverIdValue->as_int64();
+        if (requestedID < 1 || requestedID > static_cast<int64_t>(servers.size()))
             return SendFail(player, "error", sourceJobID);
 
-        auto leaderboard = servers[serverID - 1]->GetLeaderboard();
+        const auto serverID = static_cast<uint32_t>(requestedID);
+
+        // published by the arena, no access to its live state from here
+        const auto summary = servers[serverID - 1]->GetSummary();
 
-        boost::json::array sessionsJson;
-        for (auto & [targetPlayer, exp]: leaderboard)
+        // rebuilt only when the arena top changed, otherwise every poll is a copy into the envelope
+        std::shared_ptr<const std::string> response;
         {
-            boost::json::object row;
-            row["name"] = targetPlayer->Model()->GetLogin();
-            row["exp"] = exp;
-            sessionsJson.push_back(row);
+            std::lock_guard lock(cacheMutex_);
+            auto & cached = cache_[serverID];
+            if (cached.topJson != summary->topJson)
+            {
+                cached.topJson = summary->topJson;
+                cached.response = std::make_shared<const std::string>(R"({"success":true,"body":{"leaderboard":)" + *summary->topJson + "}}");
+            }
+            response = cached.response;
         }
 
-        SendSuccess(player, {{"leaderboard", sessionsJson}}, sourceJobID);
+        SendSerializedResponse(player, *response, sourceJobID);
     }
 }
@@ -4,12 +4,22 @@
 
 #include "services/game/interfaces/controller.hpp"
 
+#include <mutex>
+
 namespace Core::App::PlayerSession::Requests {
     using GameController = Game::Interface::Controller;
 
     class LeaderBoard final : public RequestsServiceInstance
     {
         GameController::Shared gameController_;
+
+        struct CachedResponse
+        {
+            std::shared_ptr<const std::string> topJson; // what response was built from
+            std::shared_ptr<const std::string> response; // sent outside the lock
+        };
+        std::mutex cacheMutex_; // requests of different clients run concurrently
+        std::unordered_map<uint32_t, CachedResponse> cache_; // serverID -> serialized success response
     public:
         void Initialise() override;
 
@@ -27,7 +27,7 @@ namespace Core::App::PlayerSession::Requests {
 
     void Login::Incoming(const Interface::Player::Shared & player, const Message::Shared & message)
     {
-        const auto sourceJobID = message->GetHeaders()->GetSourceJobID();
+        const auto sourceJobID = message->GetHeaders().GetSourceJobID();
         Log()->Debug("Incoming");
 
         const auto & model = player->Model();
@@ -43,12 +43,12 @@ namespace Core::App::PlayerSession::Requests {
 
             const std::string token = request["token"].as_string().c_str();
 
-            model->Login(token) = [=, this](bool success) {
+            AwaitOnMainLoop<bool>(player, [=] { return model->Login(token); }, [=, this](bool success) {
                 if (!success)
                     return SendFail(player, "token_out_of_date", sourceJobID);
 
                 SendSuccess(player, {{"player", player->Serialise()}}, sourceJobID);
-            };
+            });
         }
         else
         {
@@ -62,12 +62,12 @@ namespace Core::App::PlayerSession::Requests {
             if (password.empty())
                 return SendFail(player, "malformed_password", sourceJobID);
 
-            model->Login(login, password) = [=, this](bool success) {
+            AwaitOnMainLoop<bool>(player, [=] { return model->Login(login, password); }, [=, this](bool success) {
                 if (!success)
                     return SendFail(player, "user_not_found", sourceJobID);
 
                 SendSuccess(player, {{"player", player->Serialise()}}, sourceJobID);
-            };
+            });
         }
 
         // boost::json::object response;
@@ -26,7 +26,7 @@ namespace Core::App::PlayerSession::Requests {
 
     void Register::Incoming(const Interface::Player::Shared & player, const Message::Shared & message)
     {
-        const auto sourceJobID = message->GetHeaders()->GetSourceJobID();
+        const auto sourceJobID = message->GetHeaders().GetSourceJobID();
         Log()->Debug("Incoming");
 
         const auto & model = player->Model();
@@ -46,12 +46,12 @@ namespace Core::App::PlayerSession::Requests {
         if (password.empty())
             return SendFail(player, "malformed_password", sourceJobID);
 
-        model->Register(login, password) = [=, this](bool success) {
+        AwaitOnMainLoop<bool>(player, [=] { return model->Register(login, password); }, [=, this](bool success) {
             if (!success)
                 return SendFail(player, "failed_to_register", sourceJobID);
 
             SendSuccess(player, {{"player", player->Serialise()}}, sourceJobID);
-        };
+        });
 
 
         // boost::json::object response;
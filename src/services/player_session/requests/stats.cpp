@@ -32,7 +32,7 @@ namespace Core::App::PlayerSession::Requests {
 
     void Stats::Incoming(const Interface::Player::Shared & player, const Message::Shared & message)
     {
-        const auto sourceJobID = message->GetHeaders()->GetSourceJobID();
+        const auto sourceJobID = message->GetHeaders().GetSourceJobID();
         Log()->Debug("Incoming");
 
         const auto & model = player->Model();
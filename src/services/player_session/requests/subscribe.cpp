@@ -0,0 +1,110 @@
+#include "subscribe.hpp"
+
+/*
+
+{
+    "topic": "leaderboard" | "stats",
+    "serverId": 123,        // leaderboard only
+    "subscribe": true       // false to unsubscribe, default true
+}
+
+{
+    "topic": "leaderboard:123",
+    "leaderboard": [ { "name": "aaa", "exp": 123 } ]   // current state, leaderboard
+    "sessions": [ { "id": 1, "players": 1 } ]          // current state, stats
+}
+
+pushed afterwards at a bounded rate, only on change:
+    player_session::leaderboard::update  { "serverId": 123, "leaderboard": [ ... ] }
+    player_session::stats::update        { "sessions": [ changed arenas only ] }
+
+*/
+
+namespace Core::App::PlayerSession::Requests {
+
+    [[maybe_unused]] Utils::Service::Loader::Add<Subscribe> SubscribeRequest(RequestsLoader());
+
+    void Subscribe::Initialise()
+    {
+        Log()->Debug("Initializing Subscribe");
+    }
+
+    void Subscribe::OnAllInterfacesLoadedPost()
+    {
+        gameController_ = IFace().Get<GameController>();
+    }
+
+    void Subscribe::Incoming(const Interface::Player::Shared & player, const Message::Shared & message)
+    {
+        const auto sourceJobID = message->GetHeaders().GetSourceJobID();
+
+        const auto & model = player->Model();
+        if (model->GetPlayerType() == PlayerAnonymous)
+        {
+            return SendFail(player, "not_logged", sourceJobID);
+        }
+
+        auto & request = message->GetBody();
+
+        if (!request.contains("topic") || !request["topic"].is_string())
+            return SendFail(player, "error", sourceJobID);
+
+        bool subscribe = true;
+        if (request.contains("subscribe") && request["subscribe"].is_bool())
+            subscribe = request["subscribe"].as_bool();
+
+        const std::string_view topic = request["topic"].as_string();
+        const auto servers = gameController_->GetGameServers();
+
+        if (topic == "leaderboard")
+        {
+            if (!request.contains("serverId") || !request["serverId"].is_int64())
+                return SendFail(player, "error", sourceJobID);
+
+            const auto serverID = request["serverId"].as_int64();
+            if (serverID < 1 || serverID > static_cast<int64_t>(servers.size()))
+                return SendFail(player, "error", sourceJobID);
+
+            const auto topicName = Game::LeaderboardTopic(static_cast<uint32_t>(serverID));
+            if (!subscribe)
+            {
+                server_->Unsubscribe(topicName, player->GetClient());
+                return SendSuccess(player, {{"topic", topicName}}, sourceJobID);
+            }
+
+            server_->Subscribe(topicName, player->GetClient());
+
+            const auto summary = servers[serverID - 1]->GetSummary();
+            SendSerializedResponse(player,
+                                   std::format(R"({{"success":true,"body":{{"topic":"{}","leaderboard":{}}}}})", topicName, *summary->topJson),
+                                   sourceJobID);
+            return;
+        }
+
+        if (topic == "stats")
+        {
+            if (!subscribe)
+            {
+                server_->Unsubscribe(Game::StatsTopic, player->GetClient());
+                return SendSuccess(player, {{"topic", Game::StatsTopic}}, sourceJobID);
+            }
+
+            server_->Subscribe(Game::StatsTopic, player->GetClient());
+
+            boost::json::array sessionsJson;
+            for (const auto & gameServer: servers)
+            {
+                const auto summary = gameServer->GetSummary();
+
+                boost::json::object session;
+                session["id"] = summary->serverID;
+                session["players"] = summary->playersCount;
+                sessionsJson.push_back(session);
+            }
+
+            return SendSuccess(player, {{"topic", Game::StatsTopic}, {"sessions", sessionsJson}}, sourceJobID);
+        }
+
+        SendFail(player, "unknown_topic", sourceJobID);
+    }
+}
@@ -1,9 +1,25 @@
 #include "[core_loader].hpp"
 #include "logging.hpp"
 #include "coroutine.hpp"
+#include "utils.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <thread>
 
+namespace
+{
+    std::atomic<bool> shutdownRequested = false;
+
+    void OnShutdownSignal(int)
+    {
+        shutdownRequested = true;
+    }
+}
+
 [[noreturn]] int main()
 {
     const auto log = Utils::Logging::Logger::Create("CORE");
@@ -18,13 +34,45 @@
     loader.OnAllServicesLoaded();
     loader.OnAllInterfacesLoaded();
 
+    std::signal(SIGINT, OnShutdownSignal);
+    std::signal(SIGTERM, OnShutdownSignal);
+
     log->Msg("Core services initialised");
 
-    for (;;) {
+    const auto tick = [&loader]
+    {
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Core::GetMainLoop().Run();
         loader.ProcessTick();
         Utils::GetTaskManager().ClearFinishedTasks();
+    };
+
+    while (!shutdownRequested)
+        tick();
+
+    // services keep ticking so the hooks' queries can complete
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{ Utils::EnvInt("SHUTDOWN_TIMEOUT_MS", 5000) };
+    log->Msg("Shutting down");
+
+    int code = 0;
+    while (!Core::GetShutdownHooks().Poll())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            for (const auto & name : Core::GetShutdownHooks().Pending())
+                log->Error("Shutdown hook '{}' did not finish in time", name);
+            code = 1;
+            break;
+        }
+
+        tick();
     }
+
+    log->Msg("Shutdown complete");
+
+    // services are not torn down (their io threads are still running), the process just ends
+    std::fflush(nullptr);
+    std::quick_exit(code);
 }
 
 // #include <logging.hpp>
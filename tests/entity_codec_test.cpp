@@ -0,0 +1,183 @@
+#include "services/game/entity_codec.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace Core::App::Game;
+
+namespace
+{
+    int failures = 0;
+
+    #define CHECK(expr)                                                         \
+        do {                                                                    \
+            if (!(expr)) {                                                      \
+                std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #expr); \
+                failures++;                                                     \
+            }                                                                   \
+        } while (0)
+
+    Net::SnakeState MakeSnake(const float x, const float y, const std::uint32_t experience, const std::size_t points)
+    {
+        Net::SnakeState state{};
+        state.headX = x;
+        state.headY = y;
+        state.experience = experience;
+        state.totalSegments = static_cast<std::uint16_t>(points * 2);
+        state.pointsKind = Net::SnakePointsKind::ValidationSamples;
+        state.pointsCount = static_cast<std::uint16_t>(points);
+        return state;
+    }
+
+    Net::FoodState MakeFood(const float x, const float y, const std::uint32_t power)
+    {
+        Net::FoodState state{};
+        state.x = x;
+        state.y = y;
+        state.power = power;
+        state.color = { 10, 20, 30, 255 };
+        return state;
+    }
+
+    void TestRoundTrip()
+    {
+        const auto center = Utils::Legacy::Game::AreaCenter;
+        const float radius = Utils::Legacy::Game::AreaRadius;
+        const float step = 2.0f * radius / 65535.0f;
+
+        CompactEntityWriter writer(256);
+
+        const std::vector<sf::Vector2f> body { { 1.5f, -2.25f }, { 100.0f, 200.0f }, { -radius, radius } };
+        writer.WriteSnake(Net::EntityFlags::New, 0xFFFFFFFFu, MakeSnake(12.5f, -7.0f, 0xFFFFFFFFu, body.size()), body);
+        writer.WriteSnake(Net::EntityFlags::Update, 127, MakeSnake(0.0f, 0.0f, 0, 0), {});
+
+        // quantization edges: both arena bounds, the center, and values clamped outside the arena
+        writer.WriteFood(Net::EntityFlags::New, 0, MakeFood(center.x - radius, center.y + radius, 0));
+        writer.WriteFood(Net::EntityFlags::New, 128, MakeFood(center.x, center.y, 127));
+        writer.WriteFood(Net::EntityFlags::Update, 16383, MakeFood(center.x - 2.0f * radius, center.y + 2.0f * radius, 128));
+        writer.WriteFood(Net::EntityFlags::New, 16384, MakeFood(center.x + 0.3f, center.y - 0.3f, 0xFFFFFFFFu));
+
+        // varint edges in the remove runs: adjacent IDs merge, duplicates collapse, type breaks a run
+        writer.WriteRemove(Net::EntityType::Food, 300);
+        writer.WriteRemove(Net::EntityType::Food, 301);
+        writer.WriteRemove(Net::EntityType::Food, 301);
+        writer.WriteRemove(Net::EntityType::Snake, 302);
+        writer.WriteRemove(Net::EntityType::Food, 0x0FFFFFFFu);
+
+        const auto & bytes = writer.Finish();
+
+        CompactEntities decoded;
+        CHECK(DecodeCompactEntities(bytes, decoded));
+
+        CHECK(decoded.removes.size() == 4);
+        if (decoded.removes.size() == 4)
+        {
+            CHECK(decoded.removes[0] == std::make_pair(300u, Net::EntityType::Food));
+            CHECK(decoded.removes[1] == std::make_pair(301u, Net::EntityType::Food));
+            CHECK(decoded.removes[2] == std::make_pair(302u, Net::EntityType::Snake));
+            CHECK(decoded.removes[3] == std::make_pair(0x0FFFFFFFu, Net::EntityType::Food));
+        }
+
+        CHECK(decoded.entities.size() == 6);
+        if (decoded.entities.size() != 6)
+            return;
+
+        const auto & e = decoded.entities;
+        CHECK(e[0].entityID == 0 && e[0].type == Net::EntityType::Food);
+        CHECK(e[1].entityID == 127 && e[1].type == Net::EntityType::Snake && e[1].flags == Net::EntityFlags::Update);
+        CHECK(e[2].entityID == 128 && e[2].type == Net::EntityType::Food);
+        CHECK(e[3].entityID == 16383);
+        CHECK(e[4].entityID == 16384);
+        CHECK(e[5].entityID == 0xFFFFFFFFu && e[5].type == Net::EntityType::Snake && e[5].flags == Net::EntityFlags::New);
+
+        // snakes are carried verbatim
+        CHECK(e[5].snake.experience == 0xFFFFFFFFu);
+        CHECK(e[5].snake.headX == 12.5f && e[5].snake.headY == -7.0f);
+        CHECK(e[5].points == body);
+        CHECK(e[1].points.empty());
+
+        // food positions come back within one grid step, clamped to the arena
+        CHECK(e[0].food.x == center.x - radius);
+        CHECK(std::fabs(e[0].food.y - (center.y + radius)) <= step);
+        CHECK(std::fabs(e[2].food.x - center.x) <= step);
+        CHECK(e[3].food.x == center.x - radius);
+        CHECK(std::fabs(e[3].food.y - (center.y + radius)) <= step);
+        CHECK(std::fabs(e[4].food.x - (center.x + 0.3f)) <= step);
+        CHECK(std::fabs(e[4].food.y - (center.y - 0.3f)) <= step);
+
+        CHECK(e[0].food.power == 0);
+        CHECK(e[2].food.power == 127);
+        CHECK(e[3].food.power == 128);
+        CHECK(e[4].food.power == 0xFFFFFFFFu);
+        CHECK(std::memcmp(&e[4].food.color, &e[0].food.color, sizeof(Net::Color)) == 0);
+        CHECK(e[4].food.color.r == 10 && e[4].food.color.a == 255);
+    }
+
+    void TestQuantizeEdges()
+    {
+        const auto center = Utils::Legacy::Game::AreaCenter;
+        const float radius = Utils::Legacy::Game::AreaRadius;
+
+        CHECK(QuantizeArenaAxis(center.x - radius, center.x) == 0);
+        CHECK(QuantizeArenaAxis(center.x + radius, center.x) == 65535);
+        CHECK(QuantizeArenaAxis(center.x - 10.0f * radius, center.x) == 0);
+        CHECK(QuantizeArenaAxis(center.x + 10.0f * radius, center.x) == 65535);
+        CHECK(DequantizeArenaAxis(0, center.x) == center.x - radius);
+        CHECK(std::fabs(DequantizeArenaAxis(65535, center.x) - (center.x + radius)) <= 1e-3f);
+    }
+
+    void TestEmptyAndMalformed()
+    {
+        CompactEntityWriter writer(16);
+        const auto bytes = writer.Finish();
+
+        CompactEntities decoded;
+        CHECK(DecodeCompactEntities(bytes, decoded));
+        CHECK(decoded.removes.empty() && decoded.entities.empty());
+
+        CompactEntityWriter food(64);
+        food.WriteFood(Net::EntityFlags::New, 5, MakeFood(0.0f, 0.0f, 300));
+        auto truncated = food.Finish();
+
+        // every strict prefix is rejected, as is trailing garbage
+        for (std::size_t n = 0; n < truncated.size(); ++n)
+            CHECK(!DecodeCompactEntities(std::span(truncated.data(), n), decoded));
+
+        truncated.push_back(0);
+        CHECK(!DecodeCompactEntities(truncated, decoded));
+
+        // a varint longer than five bytes
+        const std::vector<std::uint8_t> overlong { CompactEntitiesMagic, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+        CHECK(!DecodeCompactEntities(overlong, decoded));
+
+        // one remove run claiming ~4e9 IDs, and runs that only add up past the cap
+        const std::vector<std::uint8_t> hugeRun { CompactEntitiesMagic, 0x01, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x00 };
+        CHECK(!DecodeCompactEntities(hugeRun, decoded));
+
+        std::vector<std::uint8_t> manyRuns { CompactEntitiesMagic, 0x02 };
+        for (const std::uint8_t start : { 0x01, 0x7F })
+        {
+            // type, start delta, length - 1 = 0xFFFF (three-byte varint)
+            manyRuns.insert(manyRuns.end(), { 0x00, start, 0xFF, 0xFF, 0x03 });
+        }
+        manyRuns.push_back(0x00);
+        CHECK(!DecodeCompactEntities(manyRuns, decoded));
+
+        std::vector<std::uint8_t> atCap { CompactEntitiesMagic, 0x01, 0x00, 0x01, 0xFF, 0xFF, 0x03, 0x00 };
+        CHECK(DecodeCompactEntities(atCap, decoded));
+        CHECK(decoded.removes.size() == CompactEntitiesMaxRemoves);
+    }
+}
+
+int main()
+{
+    TestRoundTrip();
+    TestQuantizeEdges();
+    TestEmptyAndMalformed();
+
+    if (failures)
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+#include "servers/websocket/msgpack.hpp"
+#include "servers/websocket/protocol.hpp"
+
+#include <cstdio>
+#include <limits>
+#include <string>
+
+using namespace Core::Servers::Websocket;
+
+namespace
+{
+    int failures = 0;
+
+    #define CHECK(expr)                                                         \
+        do {                                                                    \
+            if (!(expr)) {                                                      \
+                std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #expr); \
+                failures++;                                                     \
+            }                                                                   \
+        } while (0)
+
+    bool Decode(const std::vector<uint8_t> & data, boost::json::value & out)
+    {
+        std::size_t offset = 0;
+        return DecodeMsgPack(data, offset, out) && offset == data.size();
+    }
+
+    bool Decodes(const std::vector<uint8_t> & data)
+    {
+        boost::json::value out;
+        return Decode(data, out);
+    }
+
+    // one value of every encoding width the writer picks from
+    boost::json::object MakeBody()
+    {
+        boost::json::object body;
+        body["nil"] = nullptr;
+        body["yes"] = true;
+        body["no"] = false;
+        body["double"] = -1234.5625;
+
+        boost::json::array ints;
+        for (const int64_t v : std::initializer_list<int64_t>{ 0, 127, 128, 255, 256, 65535, 65536, 4294967295, 4294967296,
+                                 -1, -32, -33, -128, -129, -32768, -32769, -2147483648, -2147483649,
+                                 std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() })
+            ints.emplace_back(v);
+        body["ints"] = std::move(ints);
+        body["uint64"] = std::numeric_limits<uint64_t>::max();
+
+        body["empty"] = "";
+        body["fixstr"] = std::string(31, 'a');
+        body["str8"] = std::string(32, 'b');
+        body["str16"] = std::string(256, 'c');
+        body["str32"] = std::string(70000, 'd');
+
+        boost::json::array array16;
+        boost::json::object map16;
+        for (int i = 0; i < 20; ++i)
+        {
+            array16.emplace_back(i);
+            map16["k" + std::to_string(i)] = boost::json::array{ i, "x" };
+        }
+        body["array16"] = std::move(array16);
+        body["map16"] = std::move(map16);
+        body["nested"] = boost::json::object{ { "a", boost::json::array{ boost::json::object{ { "b", nullptr } } } } };
+
+        return body;
+    }
+
+    void TestMsgPackRoundTrip()
+    {
+        const boost::json::value body = MakeBody();
+
+        std::vector<uint8_t> packed;
+        EncodeMsgPack(body, packed);
+
+        boost::json::value decoded;
+        CHECK(Decode(packed, decoded));
+        CHECK(decoded == body);
+
+        // values follow each other in one buffer
+        std::vector<uint8_t> two;
+        EncodeMsgPack(1, two);
+        EncodeMsgPack("two", two);
+
+        std::size_t offset = 0;
+        boost::json::value first, second;
+        CHECK(DecodeMsgPack(two, offset, first) && first == 1);
+        CHECK(DecodeMsgPack(two, offset, second) && second == "two");
+        CHECK(offset == two.size());
+
+        // accepted from clients, never written
+        boost::json::value value;
+        CHECK(Decode({ 0xCA, 0x3F, 0xC0, 0x00, 0x00 }, value) && value.is_double() && value.get_double() == 1.5);
+        CHECK(Decode({ 0xC4, 0x02, 'h', 'i' }, value) && value == "hi");
+    }
+
+    void TestMsgPackMalformed()
+    {
+        std::vector<uint8_t> packed;
+        EncodeMsgPack(MakeBody(), packed);
+
+        // every proper prefix is truncated somewhere
+        bool anyPrefixDecoded = false;
+        for (std::size_t size = 0; size < packed.size(); size += 1 + size / 64)
+            anyPrefixDecoded |= Decodes(std::vector<uint8_t>(packed.begin(), packed.begin() + static_cast<std::ptrdiff_t>(size)));
+        CHECK(!anyPrefixDecoded);
+
+        CHECK(!Decodes({}));
+        CHECK(!Decodes({ 0xC1 }));                              // never used
+        CHECK(!Decodes({ 0xD4, 0x01, 0x00 }));                  // fixext 1
+        CHECK(!Decodes({ 0x81, 0x01, 0x02 }));                  // non-string key
+        CHECK(!Decodes({ 0xDD, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0 })); // array32 larger than the input
+        CHECK(!Decodes({ 0xDF, 0x7F, 0xFF, 0xFF, 0xFF, 0xA0 })); // map32 larger than the input
+        CHECK(!Decodes({ 0xDB, 0x00, 0x01, 0x00, 0x00, 'x' }));  // str32 larger than the input
+        CHECK(!Decodes({ 0xCF, 0x00, 0x00 }));                  // short uint64
+
+        // nesting is bounded
+        std::vector<uint8_t> deep(64, 0x91);
+        deep.push_back(0xC0);
+        CHECK(Decodes(deep));
+        deep.insert(deep.begin(), 0x91);
+        CHECK(!Decodes(deep));
+    }
+
+    void TestEnvelopeRoundTrip()
+    {
+        {
+            std::vector<uint8_t> frame;
+            EncodeBinaryEnvelope(frame, 7, "ignored", 0, std::numeric_limits<uint64_t>::max());
+            const auto bodyOffset = frame.size();
+            EncodeMsgPack(boost::json::object{ { "x", 1 } }, frame);
+
+            BinaryEnvelope envelope;
+            CHECK(DecodeBinaryEnvelope(frame, envelope));
+            CHECK(envelope.typeID == 7);
+            CHECK(envelope.typeName.empty());
+            CHECK(envelope.sourceJobID == 0);
+            CHECK(envelope.targetJobID == std::numeric_limits<uint64_t>::max());
+            CHECK(envelope.bodyOffset == bodyOffset);
+
+            std::size_t offset = envelope.bodyOffset;
+            boost::json::value body;
+            CHECK(DecodeMsgPack(frame, offset, body) && offset == frame.size());
+            CHECK(body.is_object() && body.get_object() == boost::json::object{ { "x", 1 } });
+        }
+
+        {
+            const std::string type = "game::unregistered_" + std::string(200, 't');
+
+            std::vector<uint8_t> frame;
+            EncodeBinaryEnvelope(frame, 0, type, 300, 1);
+
+            BinaryEnvelope envelope;
+            CHECK(DecodeBinaryEnvelope(frame, envelope));
+            CHECK(envelope.typeID == 0);
+            CHECK(envelope.typeName == type);
+            CHECK(envelope.sourceJobID == 300);
+            CHECK(envelope.targetJobID == 1);
+            CHECK(envelope.bodyOffset == frame.size());
+        }
+    }
+
+    void TestEnvelopeMalformed()
+    {
+        std::vector<uint8_t> frame;
+        EncodeBinaryEnvelope(frame, 0, "game::request_full_update", 1ull << 40, 1ull << 50);
+
+        BinaryEnvelope envelope;
+        for (std::size_t size = 0; size < frame.size(); ++size)
+            CHECK(!DecodeBinaryEnvelope(std::span(frame.data(), size), envelope));
+
+        CHECK(!DecodeBinaryEnvelope(std::vector<uint8_t>{ 0x00, BinaryVersion, 0x01, 0x00, 0x00 }, envelope));
+        CHECK(!DecodeBinaryEnvelope(std::vector<uint8_t>{ BinaryMagic, BinaryVersion + 1, 0x01, 0x00, 0x00 }, envelope));
+
+        // type id above 32 bits
+        CHECK(!DecodeBinaryEnvelope(std::vector<uint8_t>{ BinaryMagic, BinaryVersion, 0x80, 0x80, 0x80, 0x80, 0x10, 0x00, 0x00 }, envelope));
+
+        // type name longer than the frame
+        CHECK(!DecodeBinaryEnvelope(std::vector<uint8_t>{ BinaryMagic, BinaryVersion, 0x00, 0x7F, 'a', 0x00, 0x00 }, envelope));
+
+        // varint never terminates within 64 bits
+        std::vector<uint8_t> overlong { BinaryMagic, BinaryVersion, 0x01 };
+        overlong.insert(overlong.end(), 10, 0x80);
+        overlong.push_back(0x00);
+        CHECK(!DecodeBinaryEnvelope(overlong, envelope));
+    }
+
+    void TestMessageTypes()
+    {
+        MessageTypes types;
+        CHECK(types.Find("game::request_full_update") == 0);
+        CHECK(types.Name(0) == nullptr);
+
+        const auto first = types.Intern("game::request_full_update");
+        const auto second = types.Intern("websocket::hello");
+        for (int i = 0; i < 100; ++i)
+            types.Intern("type_" + std::to_string(i));
+
+        CHECK(first != 0 && second != 0 && first != second);
+        CHECK(types.Intern("game::request_full_update") == first);
+        CHECK(types.Find("game::request_full_update") == first);
+        CHECK(types.Find("websocket::hello") == second);
+        CHECK(types.Find("websocket::goodbye") == 0);
+        CHECK(types.Name(second) && *types.Name(second) == "websocket::hello");
+        CHECK(types.Name(static_cast<uint32_t>(types.Size() + 1)) == nullptr);
+        CHECK(types.Size() == 102);
+        CHECK(types.Table().size() == 102);
+    }
+}
+
+int main()
+{
+    TestMsgPackRoundTrip();
+    TestMsgPackMalformed();
+    TestEnvelopeRoundTrip();
+    TestEnvelopeMalformed();
+    TestMessageTypes();
+
+    if (failures)
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+
+    return failures ? 1 : 0;
+}